@@ -9072,6 +9072,9 @@ typedef struct _dwg_object
   BITCODE_RL num_unknown_rest;
   BITCODE_TF unknown_rest; // just the rest
 
+  BITCODE_TF raw;   /*!< with DWG_OPTS_KEEPRAW: the size bytes at address */
+  BITCODE_B  dirty; /*!< changed since decoding, raw is not written */
+
 } Dwg_Object;
 
 /**
@@ -9720,6 +9723,11 @@ typedef struct _dwg_secondheader
   BITCODE_RLL junk_r14; /*!< r14-r2000 */
 } Dwg_SecondHeader;
 
+/* Called by the decoder before it adds object num, when all previous
+   objects are complete. See dwg_stream_json. */
+typedef void (*Dwg_Decode_Hook) (struct _dwg_struct *dwg, BITCODE_BL num,
+                                 void *arg);
+
 /**
  Main DWG struct
  */
@@ -9783,6 +9791,17 @@ typedef struct _dwg_struct
   // for speedup dwg_add_handleref
   Dwg_Object_Ref **object_ordered_ref; /*! list of all ordered objects refs */
   BITCODE_BL num_object_ordered_refs;  /*! number of ordered objects refs */
+
+  // for speedup dwg_encode_get_class and dwg_require_class
+  struct _inthash *class_map; /*! dxfname hash => class index + 1 */
+  BITCODE_BS num_class_map;   /*! number of classes in class_map */
+
+  // for the decode-to-emit streaming, kept by dwg_read_file
+  Dwg_Decode_Hook decode_hook; /*! called before each decoded object */
+  void *decode_hook_arg;
+
+  // with DWG_OPTS_ARENA: the memory of the decoded objects
+  struct _dwg_arena *arena;
 } Dwg_Data;
 
 #define DWG_OPTS_LOGLEVEL 0xf
@@ -9793,6 +9812,12 @@ typedef struct _dwg_struct
 #define DWG_OPTS_INDXF    0x40
 #define DWG_OPTS_INJSON   0x80
 #define DWG_OPTS_IN       (DWG_OPTS_INDXF | DWG_OPTS_INJSON)
+/* dwg->opts only, not in dat->opts */
+#define DWG_OPTS_STREAM   0x100  /* read DXF through a fixed-size window */
+#define DWG_OPTS_THREADS  0x200  /* render DXF/JSON, encode objects in threads */
+#define DWG_OPTS_KEEPRAW  0x400  /* keep the object bits for dwg_write_file */
+#define DWG_OPTS_INCREMENTAL 0x800 /* set by dwg_write_incremental */
+#define DWG_OPTS_ARENA    0x1000 /* decode into dwg->arena, fast dwg_free */
 
 typedef enum RESBUF_VALUE_TYPE
 {
@@ -9821,6 +9846,17 @@ EXPORT int dxf_read_file (const char *restrict filename,
 // You might need to probe for that.
 EXPORT int dwg_write_file (const char *restrict filename,
                            const Dwg_Data *restrict dwg);
+/* Binary images of decoded DWGs, to skip the decoding next time.
+   Tied to the library version and platform. dwg_read_file detects them
+   also. */
+EXPORT int dwg_read_snapshot (const char *restrict filename,
+                              Dwg_Data *restrict dwg);
+EXPORT int dwg_write_snapshot (const char *restrict filename,
+                               Dwg_Data *restrict dwg);
+/* Saves the changes back to the r13-r2000 DWG the dwg was read from with
+   DWG_OPTS_KEEPRAW, appending only the changed objects and sections. */
+EXPORT int dwg_write_incremental (const char *restrict filename,
+                                  Dwg_Data *restrict dwg);
 
 /* Supports multiple preview picture types.
    Currently 3 types: BMP 2, WMF 3 and PNG as type 6.
@@ -10056,6 +10092,13 @@ EXPORT BITCODE_BS dwg_find_color_index (BITCODE_BL rgb);
 */
 EXPORT int dwg_add_object (Dwg_Data *restrict dwg);
 
+/** Mark the object as changed since decoding. dwg_write_file then encodes
+    it from its fields, and not from the bits kept with DWG_OPTS_KEEPRAW.
+    The add API and the dynapi setters do this already, only direct writes
+    into the structs need it.
+*/
+EXPORT void dwg_object_set_dirty (Dwg_Object *obj);
+
 /* Find if an object name (our internal name, not anything used elsewhere)
    is defined, and return our fixed type, the public dxfname and if it's an entity. */
 EXPORT int dwg_object_name (const char *const restrict name, // in
@@ -234,6 +234,8 @@ extern "C"
   EXPORT const Dwg_DYNAPI_field *
   dwg_dynapi_header_field (const char *restrict fieldname) __nonnull ((1));
 
+  EXPORT const Dwg_DYNAPI_field *dwg_dynapi_header_fields (void);
+
   EXPORT const Dwg_DYNAPI_field *
   dwg_dynapi_entity_field (const char *restrict name,
                            const char *restrict fieldname) __nonnull ((1, 2));
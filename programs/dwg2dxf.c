@@ -42,6 +42,7 @@ static int opts = 1;
 int minimal = 0;
 int binary = 0;
 int overwrite = 0;
+int threads = 0;
 char buf[4096];
 /* the current version per spec block */
 static unsigned int cur_ver = 0;
@@ -81,6 +82,7 @@ help (void)
   printf ("  -y, --overwrite           overwrite existing files\n");
   printf ("  -o outfile, --file        optional, only valid with one single "
           "DWGFILE\n");
+  printf ("      --threads             render the entities in parallel\n");
   printf ("      --help                display this help and exit\n");
   printf ("      --version             output version information and exit\n"
           "\n");
@@ -126,7 +128,7 @@ main (int argc, char *argv[])
           { "minimal", 0, 0, 'm' },   { "binary", 0, 0, 'b' },
           { "overwrite", 0, 0, 'y' }, { "help", 0, 0, 0 },
           { "force-free", 0, 0, 0 },  { "version", 0, 0, 0 },
-          { NULL, 0, NULL, 0 } };
+          { "threads", 0, 0, 0 },     { NULL, 0, NULL, 0 } };
 #endif
 
   if (argc < 2)
@@ -177,6 +179,8 @@ main (int argc, char *argv[])
             return help ();
           if (!strcmp (long_options[option_index].name, "force-free"))
             do_free = 1;
+          if (!strcmp (long_options[option_index].name, "threads"))
+            threads = 1;
           break;
 #else
         case 'i':
@@ -283,6 +287,8 @@ main (int argc, char *argv[])
 
       if (minimal)
         dwg.opts |= DWG_OPTS_MINIMAL;
+      if (threads)
+        dwg.opts |= DWG_OPTS_THREADS;
       {
         struct_stat_t attrib;
         if (!stat (filename_out, &attrib)) // exists
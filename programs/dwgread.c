@@ -49,6 +49,9 @@ int strcasecmp (const char *a, const char *b);
 #endif
 
 static int opts = 1;
+static int threads = 0;
+static int stream = 0;
+static int arena = 0;
 
 static int
 usage (void)
@@ -86,7 +89,18 @@ help (void)
   printf ("           Planned output formats:  YAML, XML/OGR, GPX, SVG, PS\n");
   printf ("  -o outfile                also defines the output fmt. Default: "
           "stdout\n");
+  printf ("           --threads        render DXF and JSON objects in "
+          "parallel\n");
+#    ifndef DISABLE_JSON
+  printf ("           --stream         write JSON while reading, and free "
+          "the entities\n");
+#    endif
 #  endif
+  printf ("           --snapshot file  also save a binary snapshot, read back "
+          "by dwgread\n"
+          "                            much faster than the DWG\n");
+  printf ("           --arena          decode into big blocks, which are "
+          "freed at once\n");
   printf ("           --help           display this help and exit\n");
   printf ("           --version        output version information and exit\n"
           "\n");
@@ -119,6 +133,7 @@ main (int argc, char *argv[])
   Dwg_Data dwg;
   const char *fmt = NULL;
   const char *outfile = NULL;
+  const char *snapshot = NULL;
   int has_v = 0;
   int force_free = 0;
   int c;
@@ -128,7 +143,9 @@ main (int argc, char *argv[])
       = { { "verbose", 1, &opts, 1 }, // optional
           { "format", 1, NULL, 'O' },   { "file", 1, NULL, 'o' },
           { "help", 0, NULL, 0 },       { "version", 0, NULL, 0 },
-          { "force-free", 0, NULL, 0 }, { NULL, 0, NULL, 0 } };
+          { "force-free", 0, NULL, 0 }, { "threads", 0, NULL, 0 },
+          { "stream", 0, NULL, 0 },     { "snapshot", 1, NULL, 0 },
+          { "arena", 0, NULL, 0 },      { NULL, 0, NULL, 0 } };
 #endif
 
   if (argc < 2)
@@ -179,6 +196,14 @@ main (int argc, char *argv[])
             return help ();
           if (!strcmp (long_options[option_index].name, "force-free"))
             force_free = 1;
+          if (!strcmp (long_options[option_index].name, "threads"))
+            threads = 1;
+          if (!strcmp (long_options[option_index].name, "stream"))
+            stream = 1;
+          if (!strcmp (long_options[option_index].name, "snapshot"))
+            snapshot = strdup (optarg);
+          if (!strcmp (long_options[option_index].name, "arena"))
+            arena = 1;
           break;
 #else
         case 'i':
@@ -248,11 +273,36 @@ main (int argc, char *argv[])
   memset (&dwg, 0, sizeof (Dwg_Data));
   if (has_v || !fmt)
     dwg.opts = opts;
+  if (arena)
+    dwg.opts |= DWG_OPTS_ARENA;
 #if defined(USE_TRACING) && defined(HAVE_SETENV)
   if (!has_v)
     setenv ("LIBREDWG_TRACE", "1", 0);
 #endif
 
+#if !defined(DISABLE_DXF) && !defined(DISABLE_JSON)
+  // decode and write at once
+  if (stream && fmt && optind != argc
+      && (!strcasecmp (fmt, "json") || !strcasecmp (fmt, "minjson")))
+    {
+      Bit_Chain dat = { 0 };
+      if (outfile)
+        dat.fh = fopen (outfile, "w");
+      else
+        dat.fh = stdout;
+      fprintf (stderr, "\n");
+      dat.opts = opts;
+      if ((opts & 0xf) > 1 && outfile)
+        fprintf (stderr, "Streaming DWG file %s to %sJSON file %s\n",
+                 argv[i], opts & DWG_OPTS_MINIMAL ? "minimal " : "",
+                 outfile);
+      error = dwg_stream_json (&dat, argv[i], &dwg);
+      if (outfile)
+        fclose (dat.fh);
+      goto done;
+    }
+#endif
+
   if (optind != argc)
     {
       if ((opts & 0xf) > 1)
@@ -269,6 +319,15 @@ main (int argc, char *argv[])
   if (error >= DWG_ERR_CRITICAL)
     goto done;
 
+  if (snapshot)
+    {
+      if ((opts & 0xf) > 1)
+        fprintf (stderr, "Writing snapshot %s\n", snapshot);
+      error |= dwg_write_snapshot (snapshot, &dwg);
+      if (error >= DWG_ERR_CRITICAL)
+        goto done;
+    }
+
   if (fmt)
     {
       Bit_Chain dat = { 0 };
@@ -280,6 +339,8 @@ main (int argc, char *argv[])
       dat.version = dat.from_version = dwg.header.version;
       dat.codepage = dwg.header.codepage;
       dat.opts = opts;
+      if (threads)
+        dwg.opts |= DWG_OPTS_THREADS;
       // TODO --as-rNNNN version? for now not.
       // we want the native dump, converters are separate.
 #ifndef DISABLE_DXF
@@ -334,7 +395,9 @@ done:
 #endif
 
   // forget about valgrind. really huge DWG's need endlessly here.
+  // with an arena it's cheap
   if ((dwg.header.version && dwg.num_objects < 1000) || force_free
+      || dwg.arena
 #ifdef HAVE_VALGRIND_VALGRIND_H
       || (RUNNING_ON_VALGRIND)
 #endif
@@ -344,6 +407,8 @@ done:
         free ((char *)fmt);
       if (outfile)
         free ((char *)outfile);
+      if (snapshot)
+        free ((char *)snapshot);
       dwg_free (&dwg);
     }
 
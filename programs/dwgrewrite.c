@@ -38,6 +38,7 @@ static volatile const char *__afl_persistent_sig = "##SIG_AFL_PERSISTENT##";
 #endif
 
 static int opts = 1;
+static int threads = 0;
 static int help (void);
 
 static int
@@ -69,6 +70,7 @@ help (void)
   printf ("           Planned versions:\n");
   printf ("             r2004, r2007, r2010, r2013, r2018\n");
   printf ("  -o dwgfile, --file        \n");
+  printf ("           --threads        encode the objects in parallel\n");
   printf ("           --help           display this help and exit\n");
   printf ("           --version        output version information and exit\n"
           "\n");
@@ -166,7 +168,8 @@ main (int argc, char *argv[])
   static struct option long_options[]
       = { { "verbose", 1, &opts, 1 }, // optional
           { "file", 1, 0, 'o' },      { "as", 1, 0, 'a' }, { "help", 0, 0, 0 },
-          { "version", 0, 0, 0 },     { NULL, 0, NULL, 0 } };
+          { "threads", 0, 0, 0 },     { "version", 0, 0, 0 },
+          { NULL, 0, NULL, 0 } };
 #endif
 #ifdef __AFL_HAVE_MANUAL_CONTROL
   __AFL_INIT ();
@@ -214,6 +217,8 @@ main (int argc, char *argv[])
 #  endif
               break;
             }
+          if (!strcmp (long_options[option_index].name, "threads"))
+            threads = 1;
           if (!strcmp (long_options[option_index].name, "version"))
             return opt_version ();
           if (!strcmp (long_options[option_index].name, "help"))
@@ -266,6 +271,8 @@ main (int argc, char *argv[])
 
   memset (&dwg, 0, sizeof (Dwg_Data));
   dwg.opts = opts & 0xf;
+  // copy the unchanged objects when saving as the same version
+  dwg.opts |= DWG_OPTS_KEEPRAW;
 
 #ifdef __AFL_HAVE_MANUAL_CONTROL
   while (__AFL_LOOP (1000))
@@ -358,6 +365,8 @@ main (int argc, char *argv[])
           }
       }
 
+      if (threads)
+        dwg.opts |= DWG_OPTS_THREADS;
       if (opts)
         fprintf (stderr, "\n==========================================\n");
       error = dwg_write_file (filename_out, &dwg);
@@ -48,6 +48,7 @@ static int opts = 1;
 int minimal = 0;
 int binary = 0;
 int overwrite = 0;
+int stream = 0;
 char buf[4096];
 /* the current version per spec block */
 static unsigned int cur_ver = 0;
@@ -83,6 +84,8 @@ help (void)
   printf ("             r9, r10, r11, r2004, r2007, r2010, r2013, r2018\n");
   printf ("  -o outfile, --file        optional, only valid with one single "
           "DXFFILE\n");
+  printf ("       --stream             read the DXF through a small window, "
+          "not all at once\n");
   printf ("       --help               display this help and exit\n");
   printf ("       --version            output version information and exit\n"
           "\n");
@@ -194,7 +197,7 @@ main (int argc, char *argv[])
           { "file", 1, 0, 'o' },      { "as", 1, 0, 'a' },
           { "overwrite", 0, 0, 'y' }, { "help", 0, 0, 0 },
           { "force-free", 0, 0, 0 },  { "version", 0, 0, 0 },
-          { NULL, 0, NULL, 0 } };
+          { "stream", 0, 0, 0 },      { NULL, 0, NULL, 0 } };
 #endif
 
   if (argc < 2)
@@ -244,6 +247,8 @@ main (int argc, char *argv[])
             return help ();
           if (!strcmp (long_options[option_index].name, "force-free"))
             do_free = 1;
+          if (!strcmp (long_options[option_index].name, "stream"))
+            stream = 1;
           break;
 #else
         case 'i':
@@ -318,6 +323,8 @@ main (int argc, char *argv[])
         }
 
       dwg.opts = opts;
+      if (stream)
+        dwg.opts |= DWG_OPTS_STREAM;
       dwg.header.version = dwg_version;
       printf ("Reading DXF file %s\n", filename_in);
       error = dxf_read_file (filename_in, &dwg);
@@ -55,8 +55,8 @@
       LOG_ERROR ("Invalid num_segidx");
       return DWG_ERR_VALUEOUTOFBOUNDS;
     }
-  _obj->segments = (Dwg_AcDs_Segment *)calloc (_obj->num_segidx,
-                                               sizeof (Dwg_AcDs_Segment));
+  _obj->segments = (Dwg_AcDs_Segment *)dwg_calloc (_obj->num_segidx,
+                                                   sizeof (Dwg_AcDs_Segment));
 #endif
 #ifndef IS_JSON
   if (FIELD_VALUE(num_segidx))
@@ -370,13 +370,13 @@
               {
                 LOG_ERROR ("Matching object %s " FORMAT_REF " not a 3DSOLID",
                            o ? o->name : "", ARGS_REF (hdl))
-                free (hdl);
+                dwg_free_mem (hdl);
                 error |= DWG_ERR_INVALIDHANDLE;
                 continue;
               }
             sol = o->tio.entity->tio._3DSOLID;
             // not NULL terminated
-            acis_sab_data = (char*)malloc (size);
+            acis_sab_data = (char*)dwg_malloc (size);
             memcpy (acis_sab_data, s, size);
             num_acis_sab_data++;
             dwg_dynapi_entity_set_value (sol, o->name, "acis_data", &acis_sab_data, 0);
@@ -388,8 +388,9 @@
             // wires and silhuettes
             LOG_TRACE ("%s.acis_data = %" PRIuSIZE " " FORMAT_REF "\n", o->name, size,
                        ARGS_REF (hdl))
-            free (hdl); // it is a non-global, free'able handleref. Created in
-                        // common_entity_data.spec
+            // it is a non-global, free'able handleref. Created in
+            // common_entity_data.spec
+            dwg_free_mem (hdl);
             i = (j + size) & UINT_MAX; // next offset to try
           }
         else
@@ -411,7 +412,7 @@
                   "data\n",
                   wanted, num_acis_sab_data);
         while (dwg->num_acis_sab_hdl > 0)
-          free (SHIFT_HV (dwg, num_acis_sab_hdl, acis_sab_hdl));
+          dwg_free_mem (SHIFT_HV (dwg, num_acis_sab_hdl, acis_sab_hdl));
       }
   }
 #endif
@@ -0,0 +1,196 @@
+/*****************************************************************************/
+/*  LibreDWG - free implementation of the DWG file format                    */
+/*                                                                           */
+/*  Copyright (C) 2026 Free Software Foundation, Inc.                        */
+/*                                                                           */
+/*  This library is free software, licensed under the terms of the GNU       */
+/*  General Public License as published by the Free Software Foundation,     */
+/*  either version 3 of the License, or (at your option) any later version.  */
+/*  You should have received a copy of the GNU General Public License        */
+/*  along with this program.  If not, see <http://www.gnu.org/licenses/>.    */
+/*****************************************************************************/
+
+/*
+ * arena.c: region allocator for the objects of a decoded Dwg_Data.
+ *          Blocks double in size up to ARENA_BLOCK_MAX, bigger requests
+ *          get a block of their own. Each allocation is prefixed with its
+ *          size, for realloc. The unused rest of a block is always zero.
+ */
+
+#include "arena.h"
+#include <string.h>
+
+#define ARENA_ALIGN 8
+#define ARENA_ROUND(n) (((n) + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1))
+#define ARENA_HDR ARENA_ROUND (sizeof (size_t))
+#define ARENA_BLOCK_HDR ARENA_ROUND (sizeof (Dwg_Arena_Block))
+#define ARENA_BLOCK_MIN (64 * 1024)
+#define ARENA_BLOCK_MAX (16 * 1024 * 1024)
+
+#define BLOCK_DATA(blk) ((char *)(blk) + ARENA_BLOCK_HDR)
+#define ALLOC_SIZE(ptr) (*(size_t *)((char *)(ptr) - ARENA_HDR))
+
+THREAD_LOCAL Dwg_Arena *dwg_arena;
+
+Dwg_Arena *
+dwg_arena_new (void)
+{
+  return (Dwg_Arena *)calloc (1, sizeof (Dwg_Arena));
+}
+
+void
+dwg_arena_delete (Dwg_Arena *arena)
+{
+  Dwg_Arena_Block *blk, *prev;
+  if (!arena)
+    return;
+  for (blk = arena->block; blk; blk = prev)
+    {
+      prev = blk->prev;
+      free (blk);
+    }
+  if (dwg_arena == arena)
+    dwg_arena = NULL;
+  free (arena);
+}
+
+Dwg_Arena *
+dwg_arena_use (Dwg_Arena *arena)
+{
+  Dwg_Arena *old = dwg_arena;
+  dwg_arena = arena;
+  return old;
+}
+
+static Dwg_Arena_Block *
+arena_block_new (Dwg_Arena *arena, size_t size)
+{
+  Dwg_Arena_Block *blk
+      = (Dwg_Arena_Block *)calloc (1, ARENA_BLOCK_HDR + size);
+  if (!blk)
+    return NULL;
+  blk->size = size;
+  arena->size += size;
+  arena->num_blocks++;
+  return blk;
+}
+
+// is ptr the last allocation in the newest block?
+static inline int
+arena_is_last (const Dwg_Arena_Block *blk, const void *ptr)
+{
+  return blk
+         && (const char *)ptr + ARENA_ROUND (ALLOC_SIZE (ptr))
+                == BLOCK_DATA (blk) + blk->used;
+}
+
+void *
+dwg_arena_alloc (Dwg_Arena *arena, size_t size)
+{
+  Dwg_Arena_Block *blk = arena->block;
+  const size_t need = ARENA_HDR + ARENA_ROUND (size);
+  char *p;
+
+  if (size > (size_t)-1 / 2)
+    return NULL;
+  if (!blk || blk->used + need > blk->size)
+    {
+      size_t bsize = blk ? blk->size * 2 : ARENA_BLOCK_MIN;
+      if (bsize > ARENA_BLOCK_MAX)
+        bsize = ARENA_BLOCK_MAX;
+      // big: a block of its own, behind the newest
+      if (blk && need > bsize / 4)
+        {
+          Dwg_Arena_Block *big = arena_block_new (arena, need);
+          if (!big)
+            return NULL;
+          big->used = need;
+          big->prev = blk->prev;
+          blk->prev = big;
+          p = BLOCK_DATA (big);
+          *(size_t *)p = size;
+          return p + ARENA_HDR;
+        }
+      if (bsize < need)
+        bsize = need;
+      blk = arena_block_new (arena, bsize);
+      if (!blk)
+        return NULL;
+      blk->prev = arena->block;
+      arena->block = blk;
+    }
+  p = BLOCK_DATA (blk) + blk->used;
+  blk->used += need;
+  *(size_t *)p = size;
+  return p + ARENA_HDR;
+}
+
+void *
+dwg_arena_realloc (Dwg_Arena *arena, void *ptr, size_t size)
+{
+  Dwg_Arena_Block *blk = arena->block;
+  size_t old;
+  void *p;
+
+  if (!ptr)
+    return dwg_arena_alloc (arena, size);
+  old = ALLOC_SIZE (ptr);
+  // grow or shrink the last allocation in place
+  if (arena_is_last (blk, ptr)
+      && blk->used - ARENA_ROUND (old) + ARENA_ROUND (size) <= blk->size)
+    {
+      blk->used -= ARENA_ROUND (old);
+      if (size < old)
+        memset ((char *)ptr + size, 0, ARENA_ROUND (old) - size);
+      blk->used += ARENA_ROUND (size);
+      ALLOC_SIZE (ptr) = size;
+      return ptr;
+    }
+  if (size <= old)
+    return ptr;
+  p = dwg_arena_alloc (arena, size);
+  if (p)
+    memcpy (p, ptr, old);
+  return p;
+}
+
+void
+dwg_arena_free (Dwg_Arena *arena, void *ptr)
+{
+  Dwg_Arena_Block *blk = arena->block;
+  if (ptr && arena_is_last (blk, ptr))
+    {
+      const size_t need = ARENA_HDR + ARENA_ROUND (ALLOC_SIZE (ptr));
+      blk->used -= need;
+      memset (BLOCK_DATA (blk) + blk->used, 0, need);
+    }
+}
+
+int
+dwg_arena_owns (const Dwg_Arena *arena, const void *ptr)
+{
+  const Dwg_Arena_Block *blk;
+  if (!ptr)
+    return 0;
+  for (blk = arena->block; blk; blk = blk->prev)
+    {
+      if ((const char *)ptr >= BLOCK_DATA (blk)
+          && (const char *)ptr < BLOCK_DATA (blk) + blk->used)
+        return 1;
+    }
+  return 0;
+}
+
+void *
+dwg_owned_realloc (Dwg_Arena *arena, void *ptr, size_t size)
+{
+  void *p;
+  size_t old;
+  if (!arena || !dwg_arena_owns (arena, ptr))
+    return realloc (ptr, size);
+  old = ALLOC_SIZE (ptr);
+  p = malloc (size);
+  if (p)
+    memcpy (p, ptr, old < size ? old : size);
+  return p;
+}
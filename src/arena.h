@@ -0,0 +1,112 @@
+/*****************************************************************************/
+/*  LibreDWG - free implementation of the DWG file format                    */
+/*                                                                           */
+/*  Copyright (C) 2026 Free Software Foundation, Inc.                        */
+/*                                                                           */
+/*  This library is free software, licensed under the terms of the GNU       */
+/*  General Public License as published by the Free Software Foundation,     */
+/*  either version 3 of the License, or (at your option) any later version.  */
+/*  You should have received a copy of the GNU General Public License        */
+/*  along with this program.  If not, see <http://www.gnu.org/licenses/>.    */
+/*****************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+/*
+ * arena.h: region allocator for the objects of a decoded Dwg_Data.
+ *          With DWG_OPTS_ARENA all object structs, strings, vectors and
+ *          handle refs are bump-allocated from a few big blocks owned by
+ *          dwg->arena, and dwg_free releases the blocks instead of
+ *          walking all objects.
+ *          The decoder allocates with dwg_malloc, dwg_calloc and
+ *          dwg_realloc, which use the thread's current arena, if any.
+ *          Memory of the arena must not be passed to free or realloc:
+ *          dwg_free_mem ignores it, and changes after decoding move it to
+ *          the heap with dwg_owned_realloc, marking the object dirty.
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include "common.h"
+
+typedef struct _dwg_arena_block
+{
+  struct _dwg_arena_block *prev;
+  size_t size; /* of the data */
+  size_t used;
+  /* the data follows, aligned */
+} Dwg_Arena_Block;
+
+typedef struct _dwg_arena
+{
+  Dwg_Arena_Block *block; /* the newest, to allocate from */
+  size_t size;            /* of all blocks */
+  unsigned num_blocks;
+} Dwg_Arena;
+
+/* The arena of the current decoder, or NULL */
+extern THREAD_LOCAL Dwg_Arena *dwg_arena;
+
+Dwg_Arena *dwg_arena_new (void);
+void dwg_arena_delete (Dwg_Arena *arena);
+/* Sets the current arena, and returns the previous one */
+Dwg_Arena *dwg_arena_use (Dwg_Arena *arena);
+
+/* Zeroed, aligned memory. Returns NULL if out of memory. */
+void *dwg_arena_alloc (Dwg_Arena *arena, size_t size);
+void *dwg_arena_realloc (Dwg_Arena *arena, void *ptr, size_t size);
+/* Only the last allocation is given back */
+void dwg_arena_free (Dwg_Arena *arena, void *ptr);
+int dwg_arena_owns (const Dwg_Arena *arena, const void *ptr);
+
+/* Moves ptr out of the arena to the heap, or reallocs it. */
+void *dwg_owned_realloc (Dwg_Arena *arena, void *ptr, size_t size);
+
+static inline void *
+dwg_malloc (size_t size)
+{
+  if (dwg_arena)
+    return dwg_arena_alloc (dwg_arena, size);
+  return malloc (size);
+}
+
+static inline void *
+dwg_calloc (size_t n, size_t size)
+{
+  if (dwg_arena)
+    {
+      if (size && n > (size_t)-1 / size)
+        return NULL;
+      return dwg_arena_alloc (dwg_arena, n * size);
+    }
+  return calloc (n, size);
+}
+
+static inline void *
+dwg_realloc (void *ptr, size_t size)
+{
+  if (dwg_arena && (!ptr || dwg_arena_owns (dwg_arena, ptr)))
+    return dwg_arena_realloc (dwg_arena, ptr, size);
+  return realloc (ptr, size);
+}
+
+static inline void
+dwg_free_mem (void *ptr)
+{
+  if (dwg_arena && dwg_arena_owns (dwg_arena, ptr))
+    dwg_arena_free (dwg_arena, ptr);
+  else
+    free (ptr);
+}
+
+/* free for changes after decoding */
+static inline void
+dwg_owned_free (const Dwg_Arena *arena, void *ptr)
+{
+  if (!arena || !dwg_arena_owns (arena, ptr))
+    free (ptr);
+}
+
+#endif
@@ -1141,9 +1141,14 @@ bit_read_MS (Bit_Chain *dat)
 void
 bit_write_MS (Bit_Chain *dat, BITCODE_MS value)
 {
-  bit_write_RS (dat, value);
   if (value > 0x7fff)
-    bit_write_RS (dat, value >> 15);
+    {
+      // lower 15 bits with the continuation bit first
+      bit_write_RS (dat, (BITCODE_RS)((value & 0x7fff) | 0x8000));
+      bit_write_RS (dat, (BITCODE_RS)(value >> 15));
+    }
+  else
+    bit_write_RS (dat, (BITCODE_RS)value);
 }
 
 /** Read bit-extrusion.
@@ -1676,7 +1681,7 @@ bit_read_TF (Bit_Chain *restrict dat, size_t length)
       return NULL;
     }
   CHK_OVERFLOW_PLUS (length, __FUNCTION__, NULL)
-  chain = (BITCODE_RC *)malloc (length + 1);
+  chain = (BITCODE_RC *)dwg_malloc (length + 1);
   if (!chain)
     {
       loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -1685,7 +1690,7 @@ bit_read_TF (Bit_Chain *restrict dat, size_t length)
     }
   if (bit_read_fixed (dat, chain, length))
     {
-      free (chain);
+      dwg_free_mem (chain);
       return NULL;
     }
   chain[length] = '\0';
@@ -1705,7 +1710,7 @@ bit_read_bits (Bit_Chain *dat, size_t bits)
   int rest = bits % 8;
   BITCODE_RC *restrict chain;
   CHK_OVERFLOW_PLUS (bytes, __FUNCTION__, NULL)
-  chain = (BITCODE_RC *)calloc (bytes + (rest ? 2 : 1), 1);
+  chain = (BITCODE_RC *)dwg_calloc (bytes + (rest ? 2 : 1), 1);
   if (!chain)
     {
       loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -1715,7 +1720,7 @@ bit_read_bits (Bit_Chain *dat, size_t bits)
 
   if (bit_read_fixed (dat, chain, bytes))
     {
-      free (chain);
+      dwg_free_mem (chain);
       return NULL;
     }
   chain[bytes] = '\0';
@@ -1834,7 +1839,7 @@ bit_read_TV (Bit_Chain *restrict dat)
   CHK_OVERFLOW_PLUS (length, __FUNCTION__, NULL)
   if (!loglevel)
     loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
-  chain = (unsigned char *)malloc (length + 1);
+  chain = (unsigned char *)dwg_malloc (length + 1);
   if (!chain)
     {
       LOG_ERROR ("Out of memory");
@@ -2317,7 +2322,7 @@ bit_read_TU (Bit_Chain *restrict dat)
   CHK_OVERFLOW_PLUS (1, __FUNCTION__, NULL)
   length = bit_read_BS (dat);
   CHK_OVERFLOW_PLUS (length * 2, __FUNCTION__, NULL)
-  ws = (BITCODE_TU)malloc ((length + 1) * 2);
+  ws = (BITCODE_TU)dwg_malloc ((length + 1) * 2);
   if (!ws)
     {
       loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2340,7 +2345,7 @@ bit_read_TU_size (Bit_Chain *restrict dat, unsigned int len)
   BITCODE_TU chain;
 
   CHK_OVERFLOW_PLUS (len * 2, __FUNCTION__, NULL)
-  chain = (BITCODE_TU)malloc ((len + 1) * 2);
+  chain = (BITCODE_TU)dwg_malloc ((len + 1) * 2);
   if (!chain)
     {
       loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2367,7 +2372,7 @@ bit_read_TU_len (Bit_Chain *restrict dat, unsigned int *lenp)
   CHK_OVERFLOW_PLUS (1, __FUNCTION__, NULL)
   length = bit_read_BS (dat);
   CHK_OVERFLOW_PLUS (length * 2, __FUNCTION__, NULL)
-  chain = (BITCODE_TU)malloc ((length + 1) * 2);
+  chain = (BITCODE_TU)dwg_malloc ((length + 1) * 2);
   if (!chain)
     {
       loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2395,7 +2400,7 @@ bit_read_T16 (Bit_Chain *restrict dat)
   CHK_OVERFLOW (__FUNCTION__, NULL)
   length = bit_read_RS (dat);
   CHK_OVERFLOW_PLUS (length, __FUNCTION__, NULL)
-  chain = (BITCODE_TV)malloc (length + 1);
+  chain = (BITCODE_TV)dwg_malloc (length + 1);
   if (!chain)
     {
       loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2420,7 +2425,7 @@ bit_read_TU16 (Bit_Chain *restrict dat)
   CHK_OVERFLOW_PLUS (2, __FUNCTION__, NULL)
   length = bit_read_RS (dat);
   CHK_OVERFLOW_PLUS (length * 2, __FUNCTION__, NULL)
-  chain = (BITCODE_TU)malloc ((length + 1) * 2);
+  chain = (BITCODE_TU)dwg_malloc ((length + 1) * 2);
   if (!chain)
     {
       loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2455,7 +2460,7 @@ bit_read_T32 (Bit_Chain *restrict dat)
                      __FUNCTION__, dat->byte, size)
           return NULL;
         }
-      wstr = (BITCODE_TU)malloc (size + 2);
+      wstr = (BITCODE_TU)dwg_malloc (size + 2);
       if (!wstr)
         {
           loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2477,7 +2482,7 @@ bit_read_T32 (Bit_Chain *restrict dat)
                      __FUNCTION__, dat->byte, size)
           return NULL;
         }
-      str = (BITCODE_T32)malloc (size + 1);
+      str = (BITCODE_T32)dwg_malloc (size + 1);
       if (!str)
         {
           loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2514,7 +2519,7 @@ bit_read_TU32 (Bit_Chain *restrict dat)
                      __FUNCTION__, dat->byte, size)
           return NULL;
         }
-      wstr = (BITCODE_TU)malloc (size + 2);
+      wstr = (BITCODE_TU)dwg_malloc (size + 2);
       if (!wstr)
         {
           loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -2550,7 +2555,7 @@ bit_read_TU32 (Bit_Chain *restrict dat)
                      __FUNCTION__, dat->byte, size)
           return NULL;
         }
-      str = (BITCODE_T32)malloc (size + 1);
+      str = (BITCODE_T32)dwg_malloc (size + 1);
       if (!str)
         {
           loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
@@ -3596,9 +3601,28 @@ BITCODE_T
 bit_set_T (Bit_Chain *dat, const char *restrict src)
 {
   if (!(IS_FROM_TU (dat)))
-    return strdup (src);
+    {
+      const size_t len = strlen (src) + 1;
+      char *str = (char *)dwg_malloc (len);
+      if (str)
+        memcpy (str, src, len);
+      return str;
+    }
   else
-    return (BITCODE_T)bit_utf8_to_TU ((char *)src, 0);
+    {
+      BITCODE_TU wstr = bit_utf8_to_TU ((char *)src, 0);
+      // into the arena of the decoder
+      if (wstr && dwg_arena)
+        {
+          const size_t size = (bit_wcs2len (wstr) + 1) * 2;
+          BITCODE_TU copy = (BITCODE_TU)dwg_malloc (size);
+          if (copy)
+            memcpy (copy, wstr, size);
+          free (wstr);
+          wstr = copy;
+        }
+      return (BITCODE_T)wstr;
+    }
 }
 
 /** Read 2 time BL bitlong (compacted data).
@@ -3817,7 +3841,7 @@ bit_read_ENC (Bit_Chain *dat, Bit_Chain *hdl_dat, Bit_Chain *str_dat,
         color->rgb = bit_read_BL (dat); // ODA bug, documented as BS
       if (flag & 0x40)
         {
-          color->handle = (BITCODE_H)calloc (1, sizeof (Dwg_Object_Ref));
+          color->handle = (BITCODE_H)dwg_calloc (1, sizeof (Dwg_Object_Ref));
           if (!color->handle)
             {
               loglevel = dat->opts & DWG_OPTS_LOGLEVEL;
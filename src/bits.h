@@ -49,6 +49,7 @@
 #include <stdbool.h>
 #include "common.h"
 #include "dwg.h"
+#include "arena.h"
 
 // DWG size limitations, invalid sizes and offsets
 #if SIZEOF_SIZE_T == 8
@@ -77,10 +78,11 @@ typedef struct _bit_chain
   Dwg_Version_Type from_version;
   FILE *fh;
   BITCODE_RS codepage;
+  struct _out_buf *outbuf; // text writers only, see out_buf.h
 } Bit_Chain;
 
 #define EMPTY_CHAIN(size)                                                     \
-  { NULL, size, 0UL, 0, 0, R_INVALID, R_INVALID, NULL, 0 }
+  { NULL, size, 0UL, 0, 0, R_INVALID, R_INVALID, NULL, 0, NULL }
 
 // only if from r2007+ DWG, not JSON, DXF, add API
 #define IS_FROM_TU(dat)                                                       \
@@ -23,6 +23,7 @@
 #include "dwg.h"
 #include "classes.h"
 #include "dynapi.h"
+#include "hash.h"
 
 // Now with direct O[1] access by type.
 static const char *const _dwg_type_names_fixed[] = {
@@ -569,24 +570,83 @@ is_dxf_class_importable (const char *name)
 }
 
 bool
-dwg_find_class (const Dwg_Data *restrict dwg, const char *dxfname,
+dwg_find_class (Dwg_Data *restrict dwg, const char *dxfname,
                 BITCODE_BS *numberp)
 {
+  int i;
   assert (dwg);
   assert (dxfname);
-  // linear search is good enough, with ~20 classes
-  for (BITCODE_BS i = 0; i < dwg->num_classes; i++)
+  i = dwg_class_index (dwg, dxfname);
+  if (i < 0)
+    return false;
+  if (numberp)
+    *numberp = dwg->dwg_class[i].number;
+  return true;
+}
+
+// FNV-1a of the dxfname. 0 is not allowed as hash key.
+static uint64_t
+class_map_key (const char *dxfname)
+{
+  uint64_t h = UINT64_C (14695981039346656037);
+  for (; *dxfname; dxfname++)
+    h = (h ^ (unsigned char)*dxfname) * UINT64_C (1099511628211);
+  return h ? h : 1;
+}
+
+/* Returns the index into dwg->dwg_class of the first class with this
+   dxfname, or -1.
+   Classes added since the last lookup, by dwg_add_class, dwg_require_class
+   or the readers, are added to dwg->class_map lazily. The map is rebuilt
+   when classes were removed, and must be freed with dwg_free_class_map
+   when a class dxfname is changed in-place. */
+int
+dwg_class_index (Dwg_Data *restrict dwg, const char *restrict dxfname)
+{
+  uint64_t i;
+  // ->dxfname is always ASCII/UTF-8, dxfname_u is the TU counterpart
+  if (dwg->num_classes < dwg->num_class_map)
+    dwg_free_class_map (dwg);
+  if (!dwg->class_map)
+    {
+      dwg->class_map = hash_new (dwg->num_classes + 16);
+      if (!dwg->class_map)
+        goto linear;
+    }
+  for (; dwg->num_class_map < dwg->num_classes; dwg->num_class_map++)
     {
-      // ->dxfname is always ASCII/UTF-8, dxfname_u is the TU counterpart
-      if (dwg->dwg_class[i].dxfname
-          && strEQ (dwg->dwg_class[i].dxfname, dxfname))
+      const char *name = dwg->dwg_class[dwg->num_class_map].dxfname;
+      if (name)
         {
-          if (numberp)
-            *numberp = dwg->dwg_class[i].number;
-          return true;
+          const uint64_t key = class_map_key (name);
+          if (hash_get (dwg->class_map, key) == HASH_NOT_FOUND)
+            hash_set (dwg->class_map, key, dwg->num_class_map + 1);
         }
     }
-  return false;
+  i = hash_get (dwg->class_map, class_map_key (dxfname));
+  if (i == HASH_NOT_FOUND)
+    return -1;
+  i--;
+  if (i < dwg->num_classes && dwg->dwg_class[i].dxfname
+      && strEQ (dwg->dwg_class[i].dxfname, dxfname))
+    return (int)i;
+linear: // out of memory or a hash collision
+  for (BITCODE_BS j = 0; j < dwg->num_classes; j++)
+    {
+      if (dwg->dwg_class[j].dxfname
+          && strEQ (dwg->dwg_class[j].dxfname, dxfname))
+        return (int)j;
+    }
+  return -1;
+}
+
+void
+dwg_free_class_map (Dwg_Data *dwg)
+{
+  if (dwg->class_map)
+    hash_free (dwg->class_map);
+  dwg->class_map = NULL;
+  dwg->num_class_map = 0;
 }
 
 // Similar to _dwg_type_name, just with immediate access, no linear/binary
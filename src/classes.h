@@ -38,8 +38,11 @@ bool is_class_unstable (const char *name) __nonnull_all;
 bool is_class_debugging (const char *name) __nonnull_all;
 bool is_class_unhandled (const char *name) __nonnull_all;
 bool is_dxf_class_importable (const char *name) __nonnull_all;
-bool dwg_find_class (const Dwg_Data *restrict dwg, const char *dxfname,
+bool dwg_find_class (Dwg_Data *restrict dwg, const char *dxfname,
                      BITCODE_BS *numberp) __nonnull ((1, 2));
+int dwg_class_index (Dwg_Data *restrict dwg, const char *restrict dxfname)
+    __nonnull_all;
+void dwg_free_class_map (Dwg_Data *dwg) __nonnull_all;
 void object_alias (char *restrict name) __nonnull_all;
 void entity_alias (char *restrict name) __nonnull_all;
 bool has_entity_DD (const Dwg_Object *obj) __nonnull_all;
@@ -392,6 +392,18 @@ EXPORT int strcasecmp (const char *a, const char *b);
 #  define ATTRIBUTE_NORETURN
 #endif
 
+/* Mutable file-static state of the exporters, which may render in
+   parallel, see out_render () */
+#if defined(__GNUC__) || defined(__clang__)
+#  define THREAD_LOCAL __thread
+#  define THREAD_LOCAL_SUPPORTED
+#elif defined(_MSC_VER)
+#  define THREAD_LOCAL __declspec (thread)
+#  define THREAD_LOCAL_SUPPORTED
+#else
+#  define THREAD_LOCAL
+#endif
+
 #if defined(_WIN32) && defined(HAVE_FUNC_ATTRIBUTE_MS_FORMAT)                 \
     && !defined(__USE_MINGW_ANSI_STDIO)
 #  define ATTRIBUTE_FORMAT(x, y) __attribute__ ((format (ms_printf, x, y)))
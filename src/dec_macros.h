@@ -126,8 +126,8 @@
               LOG_TRACE (strcat (s2, ": " FORMAT_##type " [" #type " %d]"),   \
                          rcount1, rcount2, _obj->nam, dxfgroup);              \
               GCC46_DIAG_RESTORE                                              \
-              free (s2);                                                      \
-              free (s1);                                                      \
+              dwg_free_mem (s2);                                              \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
           else                                                                \
             {                                                                 \
@@ -135,7 +135,7 @@
               LOG_TRACE (strcat (s1, ": " FORMAT_##type " [" #type " %d]"),   \
                          rcount1, _obj->nam, dxfgroup);                       \
               GCC46_DIAG_RESTORE                                              \
-              free (s1);                                                      \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
         }                                                                     \
       else                                                                    \
@@ -159,8 +159,8 @@
                          rcount1, rcount2, _obj->nam, dxfgroup,               \
                          rad2deg (_obj->nam));                                \
               GCC46_DIAG_RESTORE                                              \
-              free (s2);                                                      \
-              free (s1);                                                      \
+              dwg_free_mem (s2);                                              \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
           else                                                                \
             {                                                                 \
@@ -169,7 +169,7 @@
                                  " %d] %gº"),                                 \
                          rcount1, _obj->nam, dxfgroup, rad2deg (_obj->nam));  \
               GCC46_DIAG_RESTORE                                              \
-              free (s1);                                                      \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
         }                                                                     \
       else                                                                    \
@@ -191,8 +191,8 @@
               LOG_TRACE (strcat (s2, ": " FORMAT_##type " " #type "\n"),      \
                          rcount1, rcount2, _obj->nam)                         \
               GCC46_DIAG_RESTORE                                              \
-              free (s2);                                                      \
-              free (s1);                                                      \
+              dwg_free_mem (s2);                                              \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
           else                                                                \
             {                                                                 \
@@ -200,7 +200,7 @@
               LOG_TRACE (strcat (s1, ": " FORMAT_##type " " #type "\n"),      \
                          rcount1, _obj->nam)                                  \
               GCC46_DIAG_RESTORE                                              \
-              free (s1);                                                      \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
         }                                                                     \
       else                                                                    \
@@ -245,8 +245,8 @@
                   strcat (s2, "[%ld]: " FORMAT_##type " [" #type " %d]"),     \
                   rcount1, rcount2, vcount, value, dxf)                       \
               GCC46_DIAG_RESTORE                                              \
-              free (s2);                                                      \
-              free (s1);                                                      \
+              dwg_free_mem (s2);                                              \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
           else                                                                \
             {                                                                 \
@@ -255,7 +255,7 @@
                   strcat (s1, "[%ld]: " FORMAT_##type " [" #type " %d]"),     \
                   rcount1, vcount, value, dxf)                                \
               GCC46_DIAG_RESTORE                                              \
-              free (s1);                                                      \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
         }                                                                     \
       else                                                                    \
@@ -279,8 +279,8 @@
                                      ") [" #type " %d]"),                     \
                          rcount1, rcount2, _obj->nam.x, _obj->nam.y, dxf)     \
               GCC46_DIAG_RESTORE                                              \
-              free (s2);                                                      \
-              free (s1);                                                      \
+              dwg_free_mem (s2);                                              \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
           else                                                                \
             {                                                                 \
@@ -289,7 +289,7 @@
                                      ") [" #type " %d]"),                     \
                          rcount1, _obj->nam.x, _obj->nam.y, dxf)              \
               GCC46_DIAG_RESTORE                                              \
-              free (s1);                                                      \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
         }                                                                     \
       else                                                                    \
@@ -314,8 +314,8 @@
                          rcount1, rcount2, _obj->nam.x, _obj->nam.y,          \
                          _obj->nam.z, dxf)                                    \
               GCC46_DIAG_RESTORE                                              \
-              free (s2);                                                      \
-              free (s1);                                                      \
+              dwg_free_mem (s2);                                              \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
           else                                                                \
             {                                                                 \
@@ -324,7 +324,7 @@
                                      ", " FORMAT_BD ") [" #type " %d]"),      \
                          rcount1, _obj->nam.x, _obj->nam.y, _obj->nam.z, dxf) \
               GCC46_DIAG_RESTORE                                              \
-              free (s1);                                                      \
+              dwg_free_mem (s1);                                              \
             }                                                                 \
         }                                                                     \
       else                                                                    \
@@ -343,7 +343,7 @@
     {                                                                         \
       size_t _pos = bit_position (dat);                                       \
       if (ref)                                                                \
-        free (ref);                                                           \
+        dwg_free_mem (ref);                                                   \
       ref = dwg_decode_preR13_handleref (dat, code /*as size */, dwg);        \
       LOG_TRACE (#nam ": %hd [H(%s) %d]", (short)ref->r11_idx,                \
                  code == 1 ? "RC" : "RSd", dxf)                               \
@@ -372,7 +372,7 @@
                     HANDLER (OUTPUT, " => %s %s", dwg_ref_objname (dwg, ref), \
                              u8);                                             \
                   if (u8 && alloced)                                          \
-                    free ((void *)u8);                                        \
+                    dwg_free_mem ((void *)u8);                                \
                 }                                                             \
             }                                                                 \
           else                                                                \
@@ -432,7 +432,7 @@
                          _name ? _name : #nam, (int)vcount, ARGS_REF (ref),   \
                          dxf);                                                \
               if (_name)                                                      \
-                free (_name);                                                 \
+                dwg_free_mem (_name);                                         \
               if (dwg_ref_object_silent (dwg, ref)                            \
                   && DWG_LOGLEVEL > DWG_LOGLEVEL_TRACE)                       \
                 {                                                             \
@@ -441,7 +441,7 @@
                   HANDLER (OUTPUT, " => %s %s", dwg_ref_objname (dwg, ref),   \
                            u8);                                               \
                   if (alloced)                                                \
-                    free ((void *)u8);                                        \
+                    dwg_free_mem ((void *)u8);                                \
                 }                                                             \
             }                                                                 \
           else                                                                \
@@ -1005,7 +1005,7 @@
               HANDLER (OUTPUT, "\n");                                         \
             }                                                                 \
           LOG_TRACE_TF (tmp, rs);                                             \
-          free (tmp);                                                         \
+          dwg_free_mem (tmp);                                                 \
         }                                                                     \
       SINCE (R_13b1)                                                          \
       {                                                                       \
@@ -1085,7 +1085,7 @@
                  (int64_t)(size), (int64_t)(size) * TYPE_MAXELEMSIZE (type),  \
                  AVAIL_BITS (dat), SAFEDXFNAME);                              \
       if (_obj->nam)                                                          \
-        free (_obj->nam);                                                     \
+        dwg_free_mem (_obj->nam);                                             \
       return DWG_ERR_VALUEOUTOFBOUNDS;                                        \
     }
 #define SUB_VECTOR_CHKCOUNT(o, nam, type, size, dat)                          \
@@ -1098,7 +1098,7 @@
                  (int64_t)(size), (int64_t)(size) * TYPE_MAXELEMSIZE (type),  \
                  AVAIL_BITS (dat), dat->byte, (unsigned)dat->bit, SAFEDXFNAME);\
       if (_obj->o.nam)                                                        \
-        free (_obj->o.nam);                                                   \
+        dwg_free_mem (_obj->o.nam);                                           \
       return DWG_ERR_VALUEOUTOFBOUNDS;                                        \
     }
 #define VECTOR_CHKCOUNT_LV(nam, type, size, dat)                              \
@@ -1111,7 +1111,7 @@
                  (int64_t)(size), (int64_t)(size) * TYPE_MAXELEMSIZE (type),  \
                  AVAIL_BITS (dat), dat->byte, (unsigned)dat->bit, SAFEDXFNAME);\
       if (_obj->nam)                                                          \
-        free (_obj->nam);                                                     \
+        dwg_free_mem (_obj->nam);                                             \
       size = 0;                                                               \
       /* return DWG_ERR_VALUEOUTOFBOUNDS; */                                  \
     }
@@ -1150,7 +1150,8 @@
   if (size > 0)                                                               \
     {                                                                         \
       VECTOR_CHKCOUNT (name, type, size, dat)                                 \
-      _obj->name = (BITCODE_##type *)calloc (size, sizeof (BITCODE_##type));  \
+      _obj->name                                                              \
+          = (BITCODE_##type *)dwg_calloc (size, sizeof (BITCODE_##type));     \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)size; vcount++)                   \
@@ -1165,7 +1166,7 @@
     {                                                                         \
       SUB_VECTOR_CHKCOUNT (o, nam, type, csize, dat)                          \
       _obj->o.nam                                                             \
-          = (BITCODE_##type *)calloc (csize, sizeof (BITCODE_##type));        \
+          = (BITCODE_##type *)dwg_calloc (csize, sizeof (BITCODE_##type));    \
       if (!_obj->o.nam)                                                       \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)csize; vcount++)                  \
@@ -1180,7 +1181,7 @@
   if (_obj->o.sizefield > 0)                                                  \
     {                                                                         \
       SUB_VECTOR_CHKCOUNT (o, name, type, _obj->o.sizefield, dat)             \
-      _obj->o.name = (BITCODE_##type *)calloc (_obj->o.sizefield,             \
+      _obj->o.name = (BITCODE_##type *)dwg_calloc (_obj->o.sizefield,         \
                                                sizeof (BITCODE_##type));      \
       if (!_obj->o.name)                                                      \
         return DWG_ERR_OUTOFMEM;                                              \
@@ -1233,7 +1234,7 @@
     {                                                                         \
       _VECTOR_CHKCOUNT (name, _obj->size,                                     \
                         dat->from_version >= R_2007 ? 18 : 2, dat)            \
-      _obj->name = (char **)calloc (_obj->size, sizeof (char *));             \
+      _obj->name = (char **)dwg_calloc (_obj->size, sizeof (char *));         \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)_obj->size; vcount++)             \
@@ -1261,7 +1262,8 @@
     {                                                                         \
       int _dxf = dxf;                                                         \
       VECTOR_CHKCOUNT (name, type, size, dat)                                 \
-      _obj->name = (BITCODE_##type *)calloc (size, sizeof (BITCODE_##type));  \
+      _obj->name                                                              \
+          = (BITCODE_##type *)dwg_calloc (size, sizeof (BITCODE_##type));     \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)size; vcount++)                   \
@@ -1279,7 +1281,7 @@
 #define SUB_FIELD_VECTOR_TYPESIZE(o, name, size, typesize, dxf)               \
   if (_obj->o.size > 0)                                                       \
     {                                                                         \
-      _obj->o.name = (BITCODE_RC *)calloc (_obj->o.size, typesize);           \
+      _obj->o.name = (BITCODE_RC *)dwg_calloc (_obj->o.size, typesize);       \
       if (!_obj->o.name)                                                      \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)_obj->o.size; vcount++)           \
@@ -1314,7 +1316,8 @@
   VECTOR_CHKCOUNT_LV (name, 2RD, _obj->size, dat)                             \
   if (_obj->size > 0)                                                         \
     {                                                                         \
-      _obj->name = (BITCODE_2RD *)calloc (_obj->size, sizeof (BITCODE_2RD));  \
+      _obj->name                                                              \
+          = (BITCODE_2RD *)dwg_calloc (_obj->size, sizeof (BITCODE_2RD));     \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)_obj->size; vcount++)             \
@@ -1330,7 +1333,7 @@
   if (_obj->o.size > 0)                                                       \
     {                                                                         \
       _obj->o.name                                                            \
-          = (BITCODE_2RD *)calloc (_obj->o.size, sizeof (BITCODE_2RD));       \
+          = (BITCODE_2RD *)dwg_calloc (_obj->o.size, sizeof (BITCODE_2RD));   \
       if (!_obj->o.name)                                                      \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)_obj->o.size; vcount++)           \
@@ -1345,7 +1348,8 @@
   VECTOR_CHKCOUNT_LV (name, 2DD, _obj->size, dat)                             \
   if (_obj->size > 0)                                                         \
     {                                                                         \
-      _obj->name = (BITCODE_2RD *)calloc (_obj->size, sizeof (BITCODE_2RD));  \
+      _obj->name                                                              \
+          = (BITCODE_2RD *)dwg_calloc (_obj->size, sizeof (BITCODE_2RD));     \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
       FIELD_2RD (name[0], dxf);                                               \
@@ -1377,7 +1381,8 @@
   if (_obj->size > 0)                                                         \
     {                                                                         \
       _obj->name                                                              \
-          = (BITCODE_3DPOINT *)calloc (_obj->size, sizeof (BITCODE_3DPOINT)); \
+          = (BITCODE_3DPOINT *)dwg_calloc (_obj->size,                        \
+                                           sizeof (BITCODE_3DPOINT));         \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)_obj->size; vcount++)             \
@@ -1390,7 +1395,7 @@
   if (_obj->o.size > 0)                                                       \
     {                                                                         \
       _obj->o.name                                                            \
-          = (BITCODE_3BD *)calloc (_obj->o.size, sizeof (BITCODE_3BD));       \
+          = (BITCODE_3BD *)dwg_calloc (_obj->o.size, sizeof (BITCODE_3BD));   \
       if (!_obj->o.name)                                                      \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)_obj->o.size; vcount++)           \
@@ -1405,7 +1410,8 @@
 #define HANDLE_VECTOR_N(nam, size, code, dxf)                                 \
   if (size > 0)                                                               \
     {                                                                         \
-      FIELD_VALUE (nam) = (BITCODE_H *)calloc (size, sizeof (BITCODE_H));     \
+      FIELD_VALUE (nam)                                                       \
+          = (BITCODE_H *)dwg_calloc (size, sizeof (BITCODE_H));               \
       if (!_obj->nam)                                                         \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < (BITCODE_BL)size; vcount++)                   \
@@ -1423,7 +1429,7 @@
     {                                                                         \
       BITCODE_BL _size = _obj->o.sizefield;                                   \
       HANDLE_VECTOR_CHKCOUNT (nam, _size)                                     \
-      _obj->o.nam = (BITCODE_H *)calloc (_size, sizeof (BITCODE_H));          \
+      _obj->o.nam = (BITCODE_H *)dwg_calloc (_size, sizeof (BITCODE_H));      \
       if (!_obj->o.nam)                                                       \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < _size; vcount++)                              \
@@ -1458,7 +1464,7 @@
   if (obj->tio.object->num_reactors > 0)                                      \
     {                                                                         \
       HANDLE_VECTOR_CHKCOUNT (reactors, obj->tio.object->num_reactors)        \
-      obj->tio.object->reactors = (BITCODE_H *)calloc (                       \
+      obj->tio.object->reactors = (BITCODE_H *)dwg_calloc (                   \
           obj->tio.object->num_reactors, sizeof (BITCODE_H));                 \
       if (!obj->tio.object->reactors)                                         \
         return DWG_ERR_OUTOFMEM;                                              \
@@ -1474,7 +1480,8 @@
     {                                                                         \
       HANDLE_VECTOR_CHKCOUNT (reactors, _ent->num_reactors)                   \
       _ent->reactors                                                          \
-          = (BITCODE_H *)calloc (_ent->num_reactors, sizeof (BITCODE_H));     \
+          = (BITCODE_H *)dwg_calloc (_ent->num_reactors,                      \
+                                     sizeof (BITCODE_H));                     \
       if (!_ent->reactors)                                                    \
         return DWG_ERR_OUTOFMEM;                                              \
       for (vcount = 0; vcount < _ent->num_reactors; vcount++)                 \
@@ -1527,7 +1534,7 @@
       BITCODE_TF unknown = bit_read_TF (dat, (size_t)len);                    \
       LOG_TRACE ("unknown (%ld): ", len);                                     \
       LOG_TRACE_TF (unknown, len);                                            \
-      free (unknown);                                                         \
+      dwg_free_mem (unknown);                                                 \
     }                                                                         \
   dat->byte = (size_t)(pos)
 
@@ -1574,7 +1581,7 @@
       LOG_ERROR ("Invalid " #name " in %s. No bytes left.\n", SAFEDXFNAME);   \
       if (_obj->name)                                                         \
         {                                                                     \
-          free (_obj->name);                                                  \
+          dwg_free_mem (_obj->name);                                          \
           _obj->name = NULL;                                                  \
         }                                                                     \
       return DWG_ERR_VALUEOUTOFBOUNDS;                                        \
@@ -1588,7 +1595,7 @@
                  (unsigned long)times);                                       \
       if (_obj->name)                                                         \
         {                                                                     \
-          free (_obj->name);                                                  \
+          dwg_free_mem (_obj->name);                                          \
           _obj->name = NULL;                                                  \
         }                                                                     \
       return DWG_ERR_VALUEOUTOFBOUNDS;                                        \
@@ -1600,7 +1607,7 @@
       times = 0;                                                              \
       if (_obj->name)                                                         \
         {                                                                     \
-          free (_obj->name);                                                  \
+          dwg_free_mem (_obj->name);                                          \
           _obj->name = NULL;                                                  \
         }                                                                     \
       return DWG_ERR_VALUEOUTOFBOUNDS;                                        \
@@ -1616,7 +1623,7 @@
       times = 0;                                                              \
       if (_obj->name)                                                         \
         {                                                                     \
-          free (_obj->name);                                                  \
+          dwg_free_mem (_obj->name);                                          \
           _obj->name = NULL;                                                  \
         }                                                                     \
       return DWG_ERR_VALUEOUTOFBOUNDS;                                        \
@@ -1633,7 +1640,7 @@
 #define REPEAT_CN(times, name, type)                                          \
   if (times > 0)                                                              \
     {                                                                         \
-      _obj->name = (type *)calloc (times, sizeof (type));                     \
+      _obj->name = (type *)dwg_calloc (times, sizeof (type));                 \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
     }                                                                         \
@@ -1643,7 +1650,7 @@
   REPEAT_CHKCOUNT (name, times, type)                                         \
   if (times > 0)                                                              \
     {                                                                         \
-      _obj->name = (type *)calloc (times, sizeof (type));                     \
+      _obj->name = (type *)dwg_calloc (times, sizeof (type));                 \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
     }                                                                         \
@@ -1654,7 +1661,7 @@
   REPEAT_CHKCOUNT_LVAL (nam, _obj->times, type)                               \
   if (_obj->times > 0)                                                        \
     {                                                                         \
-      _obj->nam = (type *)calloc (_obj->times, sizeof (type));                \
+      _obj->nam = (type *)dwg_calloc (_obj->times, sizeof (type));            \
       if (!_obj->nam)                                                         \
         return DWG_ERR_OUTOFMEM;                                              \
     }                                                                         \
@@ -1662,13 +1669,13 @@
 // unchecked with var. times
 #define _REPEAT_C(times, name, type, idx)                                     \
   if (_obj->times > 0)                                                        \
-    _obj->name = (type *)calloc (_obj->times, sizeof (type));                 \
+    _obj->name = (type *)dwg_calloc (_obj->times, sizeof (type));             \
   for (rcount##idx = 0; rcount##idx < (BITCODE_BL)_obj->times; rcount##idx++)
 // unchecked with constant times
 #define _REPEAT_CN(times, name, type, idx)                                    \
   if (times > 0)                                                              \
     {                                                                         \
-      _obj->name = (type *)calloc (times, sizeof (type));                     \
+      _obj->name = (type *)dwg_calloc (times, sizeof (type));                 \
       if (!_obj->name)                                                        \
         return DWG_ERR_OUTOFMEM;                                              \
     }                                                                         \
@@ -1746,11 +1753,11 @@
           obj->name = strdup (obj->name);                                     \
       }                                                                       \
     _ent = obj->tio.entity                                                    \
-        = (Dwg_Object_Entity *)calloc (1, sizeof (Dwg_Object_Entity));        \
+        = (Dwg_Object_Entity *)dwg_calloc (1, sizeof (Dwg_Object_Entity));    \
     if (!_ent)                                                                \
       return DWG_ERR_OUTOFMEM;                                                \
     _ent->tio.token                                                           \
-        = (Dwg_Entity_##token *)calloc (1, sizeof (Dwg_Entity_##token));      \
+        = (Dwg_Entity_##token *)dwg_calloc (1, sizeof (Dwg_Entity_##token));  \
     if (!_ent->tio.token)                                                     \
       return DWG_ERR_OUTOFMEM;                                                \
     _ent->dwg = obj->parent;                                                  \
@@ -1836,14 +1843,14 @@
     LOG_INFO ("Add object " #token " [%d] ", obj->index)                      \
     obj->supertype = DWG_SUPERTYPE_OBJECT;                                    \
     obj->tio.object                                                           \
-        = (Dwg_Object_Object *)calloc (1, sizeof (Dwg_Object_Object));        \
+        = (Dwg_Object_Object *)dwg_calloc (1, sizeof (Dwg_Object_Object));    \
     if (!obj->tio.object)                                                     \
       return DWG_ERR_OUTOFMEM;                                                \
     _obj = obj->tio.object->tio.token                                         \
-        = (Dwg_Object_##token *)calloc (1, sizeof (Dwg_Object_##token));      \
+        = (Dwg_Object_##token *)dwg_calloc (1, sizeof (Dwg_Object_##token));  \
     if (!_obj)                                                                \
       {                                                                       \
-        free (obj->tio.object);                                               \
+        dwg_free_mem (obj->tio.object);                                       \
         obj->tio.object = NULL;                                               \
         obj->fixedtype = DWG_TYPE_FREED;                                      \
         return DWG_ERR_OUTOFMEM;                                              \
@@ -1930,14 +1937,14 @@
     LOG_INFO ("Add table record " #token " [%d] ", obj->index)                \
     obj->supertype = DWG_SUPERTYPE_OBJECT;                                    \
     obj->tio.object                                                           \
-        = (Dwg_Object_Object *)calloc (1, sizeof (Dwg_Object_Object));        \
+        = (Dwg_Object_Object *)dwg_calloc (1, sizeof (Dwg_Object_Object));    \
     if (!obj->tio.object)                                                     \
       return DWG_ERR_OUTOFMEM;                                                \
     _obj = obj->tio.object->tio.token                                         \
-        = (Dwg_Object_##token *)calloc (1, sizeof (Dwg_Object_##token));      \
+        = (Dwg_Object_##token *)dwg_calloc (1, sizeof (Dwg_Object_##token));  \
     if (!_obj)                                                                \
       {                                                                       \
-        free (obj->tio.object);                                               \
+        dwg_free_mem (obj->tio.object);                                       \
         obj->tio.object = NULL;                                               \
         obj->fixedtype = DWG_TYPE_FREED;                                      \
         return DWG_ERR_OUTOFMEM;                                              \
@@ -222,23 +222,40 @@ dwg_decode (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
       }
     return error;
   }
-  VERSIONS (R_13b1, R_2000)
-  {
-    return decode_R13_R2000 (dat, dwg);
-  }
-  VERSIONS (R_2004a, R_2004)
-  {
-    return decode_R2004 (dat, dwg);
-  }
-  VERSIONS (R_2007a, R_2007)
-  {
-    return decode_R2007 (dat, dwg);
-  }
-  SINCE (R_2010b)
-  {
-    read_r2007_init (dwg); // sets loglevel only for now
-    return decode_R2004 (dat, dwg);
-  }
+  if (dat->from_version < R_AFTER)
+    {
+      int error = DWG_ERR_INVALIDDWG;
+      Dwg_Arena *old_arena = dwg_arena;
+      // the decoded objects are allocated from the arena
+      if (dwg->opts & DWG_OPTS_ARENA)
+        {
+          if (!dwg->arena)
+            dwg->arena = dwg_arena_new ();
+          dwg_arena_use (dwg->arena);
+        }
+      VERSIONS (R_13b1, R_2000)
+      {
+        error = decode_R13_R2000 (dat, dwg);
+      }
+      VERSIONS (R_2004a, R_2004)
+      {
+        error = decode_R2004 (dat, dwg);
+      }
+      VERSIONS (R_2007a, R_2007)
+      {
+        error = decode_R2007 (dat, dwg);
+      }
+      SINCE (R_2010b)
+      {
+        read_r2007_init (dwg); // sets loglevel only for now
+        error = decode_R2004 (dat, dwg);
+      }
+      dwg_arena_use (old_arena);
+      if (dwg->arena)
+        LOG_TRACE ("arena: %u blocks, %" PRIuSIZE " bytes\n",
+                  dwg->arena->num_blocks, dwg->arena->size)
+      return error;
+    }
 
   // This line should not be reached
   LOG_ERROR ("LibreDWG does not support this DWG version: %s (%s).", magic,
@@ -660,7 +677,7 @@ classes_section:
       LOG_POS_ (HANDLE);
       if (dat->byte >= endpos)
         {
-          free (klass->appname);
+          dwg_free_mem (klass->appname);
           break;
         }
       LOG_HANDLE ("\n  ");
@@ -1073,11 +1090,11 @@ bfr_read_32 (void *restrict dst, BITCODE_RC *restrict *restrict src,
     }
 
   if (src_unaligned)
-    free ((void *)sp0);
+    dwg_free_mem ((void *)sp0);
   if (dst_unaligned)
     {
       memcpy ((void *)dst, (const void *)dp0, size);
-      free ((void *)dp0);
+      dwg_free_mem ((void *)dp0);
     }
   *src += size;
   size -= n * sizeof (uint32_t);
@@ -1120,11 +1137,11 @@ bfr_read_64 (void *restrict dst, BITCODE_RC *restrict *restrict src,
     }
 
   if (src_unaligned)
-    free ((void *)sp0);
+    dwg_free_mem ((void *)sp0);
   if (dst_unaligned)
     {
       memcpy ((void *)dst, (const void *)dp0, size);
-      free ((void *)dp0);
+      dwg_free_mem ((void *)dp0);
     }
   *src += size;
   size -= n * sizeof (uint64_t);
@@ -1466,7 +1483,7 @@ read_R2004_section_map (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
                                     comp_data_size);
   if (error > DWG_ERR_CRITICAL || error == DWG_ERR_VALUEOUTOFBOUNDS)
     {
-      free (decomp);
+      dwg_free_mem (decomp);
       return error;
     }
   LOG_TRACE ("\n#### Read 2004 Section Page Map @%x ####\n",
@@ -1539,7 +1556,7 @@ read_R2004_section_map (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
       i++;
     }
   i--;
-  free (decomp);
+  dwg_free_mem (decomp);
 
   if (max_id != section_array_size)
     {
@@ -1692,7 +1709,7 @@ read_R2004_section_info (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
                                     comp_data_size);
   if (error > DWG_ERR_CRITICAL || error == DWG_ERR_VALUEOUTOFBOUNDS)
     {
-      free (decomp);
+      dwg_free_mem (decomp);
       return error;
     }
 
@@ -1709,7 +1726,7 @@ read_R2004_section_info (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
       > 0xc0000000 / sizeof (Dwg_Section_Info))
     {
       LOG_ERROR ("Illegal num_desc");
-      free (decomp);
+      dwg_free_mem (decomp);
       dwg->header.section_infohdr.num_desc = 0;
       dwg->header.section_infohdr.num_desc2 = 0;
       return error | DWG_ERR_INVALIDDWG;
@@ -1731,7 +1748,7 @@ read_R2004_section_info (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
 
       if (ptr + 32 + 64 >= decomp_end)
         {
-          free (decomp);
+          dwg_free_mem (decomp);
           dwg->header.section_infohdr.num_desc = i;
           LOG_ERROR ("read_R2004_section_info out of range");
           return DWG_ERR_INVALIDDWG;
@@ -1762,7 +1779,7 @@ read_R2004_section_info (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
           info->num_sections = 0;
           info->sections = NULL;
           dwg->header.section_infohdr.num_desc = i;
-          free (decomp);
+          dwg_free_mem (decomp);
           LOG_ERROR ("read_R2004_section_info out of range");
           return DWG_ERR_INVALIDDWG;
         }
@@ -1811,7 +1828,7 @@ read_R2004_section_info (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
                                                    sizeof (Dwg_Section *));
           if (!info->sections)
             {
-              free (decomp);
+              dwg_free_mem (decomp);
               LOG_ERROR ("Out of memory with %u sections", info->num_sections);
               return error | DWG_ERR_OUTOFMEM;
             }
@@ -1907,11 +1924,11 @@ read_R2004_section_info (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
           LOG_ERROR ("Section count %u in area %d too high! Skipping",
                      info->num_sections, i);
           info->num_sections = 0;
-          free (decomp);
+          dwg_free_mem (decomp);
           return error | DWG_ERR_VALUEOUTOFBOUNDS;
         }
     }
-  free (decomp);
+  dwg_free_mem (decomp);
   return error;
 }
 
@@ -1996,7 +2013,7 @@ read_2004_compressed_section (Bit_Chain *dat, Dwg_Data *restrict dwg,
           sec->address = 128;
           sec->size = 128;
           if (info->sections) // [0] is NULL anyway
-            free (info->sections);
+            dwg_free_mem (info->sections);
           info->sections = calloc (1, sizeof (Dwg_Section*));
           info->sections[0] = sec;
         }
@@ -2052,7 +2069,7 @@ read_2004_compressed_section (Bit_Chain *dat, Dwg_Data *restrict dwg,
           if (i == info->num_sections - 1) // the last one
             {
               sec_dat->chain = NULL; // fix double-free
-              free (decomp);
+              dwg_free_mem (decomp);
               return DWG_ERR_SECTIONNOTFOUND;
             }
           j--; // index for writing info->max_decomp_size chunks
@@ -2109,7 +2126,7 @@ read_2004_compressed_section (Bit_Chain *dat, Dwg_Data *restrict dwg,
           if (error > DWG_ERR_CRITICAL)
             {
               sec_dat->chain = NULL; // fix double-free
-              free (decomp);
+              dwg_free_mem (decomp);
               return error;
             }
           bytes_left -= info->max_decomp_size;
@@ -2126,7 +2143,7 @@ read_2004_compressed_section (Bit_Chain *dat, Dwg_Data *restrict dwg,
             {
               LOG_ERROR ("Some section size or address out of bounds")
               sec_dat->chain = NULL;
-              free (decomp);
+              dwg_free_mem (decomp);
               return type < SECTION_REVHISTORY ? DWG_ERR_INVALIDDWG
                                                : DWG_ERR_VALUEOUTOFBOUNDS;
             }
@@ -2158,7 +2175,7 @@ read_2004_section_classes (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_ERROR ("Failed to read compressed %s section", "Classes");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return error;
     }
 
@@ -2197,7 +2214,7 @@ read_2004_section_classes (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
           LOG_ERROR ("Invalid max class number %d", (int)max_num)
           dwg->num_classes = 0;
           if (sec_dat.chain)
-            free (sec_dat.chain);
+            dwg_free_mem (sec_dat.chain);
           return DWG_ERR_VALUEOUTOFBOUNDS;
         }
       assert (max_num >= 500);
@@ -2211,7 +2228,7 @@ read_2004_section_classes (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
         {
           LOG_ERROR ("Out of memory");
           if (sec_dat.chain)
-            free (sec_dat.chain);
+            dwg_free_mem (sec_dat.chain);
           return DWG_ERR_OUTOFMEM;
         }
 
@@ -2247,7 +2264,7 @@ read_2004_section_classes (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
                                 0)
                   LOG_TRACE_TU ("DXF record name ",
                                 dwg->dwg_class[i].dxfname_u, 0)
-                  free (appu8);
+                  dwg_free_mem (appu8);
                 }
             }
           else
@@ -2289,7 +2306,7 @@ read_2004_section_classes (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   else
     {
       LOG_ERROR ("Failed to find class section sentinel");
-      free (sec_dat.chain);
+      dwg_free_mem (sec_dat.chain);
       return DWG_ERR_CLASSESNOTFOUND;
     }
 
@@ -2297,7 +2314,7 @@ read_2004_section_classes (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   // dwg_sentinel(DWG_SENTINEL_CLASS_END)
   // SINCE(R_2004) 8 unknown bytes
 
-  free (sec_dat.chain);
+  dwg_free_mem (sec_dat.chain);
   return 0;
 }
 
@@ -2315,7 +2332,7 @@ read_2004_section_header (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_ERROR ("Failed to read compressed %s section", "Header");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return error;
     }
   if (dat->size - dat->byte <= 200)
@@ -2359,7 +2376,7 @@ read_2004_section_header (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
             |= dwg_decode_header_variables (&sec_dat, &hdl_dat, &str_dat, dwg);
       }
     }
-  free (sec_dat.chain);
+  dwg_free_mem (sec_dat.chain);
   return error;
 }
 
@@ -2379,7 +2396,7 @@ read_2004_section_handles (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_ERROR ("Failed to read compressed %s section", "AcDbObjects");
       if (obj_dat.chain)
-        free (obj_dat.chain);
+        dwg_free_mem (obj_dat.chain);
       return error;
     }
 
@@ -2387,9 +2404,9 @@ read_2004_section_handles (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   if (error >= DWG_ERR_CRITICAL || !hdl_dat.chain)
     {
       LOG_ERROR ("Failed to read compressed %s section", "Handles");
-      free (obj_dat.chain);
+      dwg_free_mem (obj_dat.chain);
       if (hdl_dat.chain)
-        free (hdl_dat.chain);
+        dwg_free_mem (hdl_dat.chain);
       return error;
     }
 
@@ -2414,9 +2431,9 @@ read_2004_section_handles (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
         {
           LOG_ERROR ("Object-map/handles page size greater than 2040!");
           if (hdl_dat.chain)
-            free (hdl_dat.chain);
+            dwg_free_mem (hdl_dat.chain);
           if (obj_dat.chain)
-            free (obj_dat.chain);
+            dwg_free_mem (obj_dat.chain);
           return DWG_ERR_VALUEOUTOFBOUNDS;
         }
 
@@ -2510,8 +2527,8 @@ read_2004_section_handles (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     }
   while (section_size > 2);
 
-  free (hdl_dat.chain);
-  free (obj_dat.chain);
+  dwg_free_mem (hdl_dat.chain);
+  dwg_free_mem (obj_dat.chain);
   return error;
 }
 
@@ -2544,7 +2561,7 @@ read_2004_section_summary (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_ERROR ("Failed to read uncompressed %s section", "SummaryInfo");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return error;
     }
   if (dwg->header.summaryinfo_address != (BITCODE_RL)dat->byte)
@@ -2559,7 +2576,7 @@ read_2004_section_summary (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   error = summaryinfo_private (dat, dwg);
 
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2643,7 +2660,7 @@ read_2004_section_auxheader (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_ERROR ("Failed to read uncompressed %s section", "AuxHeader");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return error;
     }
 
@@ -2656,7 +2673,7 @@ read_2004_section_auxheader (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2709,7 +2726,7 @@ read_2004_section_appinfo (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_ERROR ("Failed to read uncompressed %s section", "AppInfo");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return error;
     }
 
@@ -2722,7 +2739,7 @@ read_2004_section_appinfo (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2757,7 +2774,7 @@ read_2004_section_filedeplist (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_INFO ("%s section not found\n", "FileDepList");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -2771,7 +2788,7 @@ read_2004_section_filedeplist (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2806,7 +2823,7 @@ read_2004_section_security (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_INFO ("%s section not found\n", "Security");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -2819,7 +2836,7 @@ read_2004_section_security (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2852,7 +2869,7 @@ read_2004_section_signature (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_INFO ("%s section not found\n", secname)
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -2865,7 +2882,7 @@ read_2004_section_signature (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2891,7 +2908,7 @@ read_2004_section_vbaproject (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_INFO ("%s section not found\n", "VBAProject");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -2908,7 +2925,7 @@ read_2004_section_vbaproject (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2929,7 +2946,7 @@ read_2004_section_appinfohistory (Bit_Chain *restrict dat,
     {
       LOG_INFO ("%s section not found\n", "AppInfoHistory");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -2946,7 +2963,7 @@ read_2004_section_appinfohistory (Bit_Chain *restrict dat,
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -2981,7 +2998,7 @@ read_2004_section_revhistory (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_INFO ("%s section not found\n", "RevHistory");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -2994,7 +3011,7 @@ read_2004_section_revhistory (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -3016,7 +3033,7 @@ read_2004_section_objfreespace (Bit_Chain *restrict dat,
     {
       LOG_INFO ("%s section not found\n", "ObjFreeSpace");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -3032,7 +3049,7 @@ read_2004_section_objfreespace (Bit_Chain *restrict dat,
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -3059,7 +3076,7 @@ read_2004_section_template (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
         LOG_ERROR ("%s section not found\n", "Template")
       }
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -3072,7 +3089,7 @@ read_2004_section_template (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -3109,7 +3126,7 @@ read_2004_section_acds (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_INFO ("%s section not found\n", secname)
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return 0;
     }
 
@@ -3124,7 +3141,7 @@ read_2004_section_acds (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   LOG_TRACE ("\n")
   if (sec_dat.chain)
-    free (sec_dat.chain);
+    dwg_free_mem (sec_dat.chain);
   *dat = old_dat; // unrestrict
   return error;
 }
@@ -3144,7 +3161,7 @@ read_2004_section_preview (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_ERROR ("Failed to read uncompressed %s section", "Preview");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return error;
     }
 
@@ -3156,14 +3173,14 @@ read_2004_section_preview (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     {
       LOG_WARN ("Empty thumbnail");
       if (sec_dat.chain)
-        free (sec_dat.chain);
+        dwg_free_mem (sec_dat.chain);
       return error;
     }
   sentinel = (unsigned char *)dwg_sentinel (DWG_SENTINEL_THUMBNAIL_BEGIN);
   if (memcmp (sentinel, sec_dat.chain, 16))
     {
       LOG_WARN ("thumbnail sentinel mismatch");
-      free (sec_dat.chain);
+      dwg_free_mem (sec_dat.chain);
       return error;
     }
   assert (sec_dat.size >= 32);
@@ -3606,7 +3623,7 @@ dwg_decode_eed_data (Bit_Chain *restrict dat, Dwg_Eed_Data *restrict data,
           {
             char *u8 = bit_TU_to_utf8_len (data->u.eed_0_r2007.string, lens);
             LOG_TRACE ("wstring: len=%d [RS] \"%s\" [TU]", (int)lens, u8);
-            free (u8);
+            dwg_free_mem (u8);
           }
 #endif
       }
@@ -3763,13 +3780,13 @@ dwg_decode_eed (Bit_Chain *restrict dat, Dwg_Object_Object *restrict obj)
       obj->num_eed = idx + 1;
       if (idx) /* just extend by one. not in chunks for now */
         {
-          obj->eed
-              = (Dwg_Eed *)realloc (obj->eed, obj->num_eed * sizeof (Dwg_Eed));
+          obj->eed = (Dwg_Eed *)dwg_realloc (obj->eed,
+                                             obj->num_eed * sizeof (Dwg_Eed));
           memset (&obj->eed[idx], 0, sizeof (Dwg_Eed));
         }
       else
         {
-          obj->eed = (Dwg_Eed *)calloc (1, sizeof (Dwg_Eed));
+          obj->eed = (Dwg_Eed *)dwg_calloc (1, sizeof (Dwg_Eed));
         }
       obj->eed[idx].size = size;
       if (dat->from_version >= R_13b1)
@@ -3845,7 +3862,7 @@ dwg_decode_eed (Bit_Chain *restrict dat, Dwg_Object_Object *restrict obj)
 
       while (dat->byte < end)
         {
-          obj->eed[idx].data = (Dwg_Eed_Data *)calloc (size + 8, 1);
+          obj->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (size + 8, 1);
           LOG_TRACE ("EED[%u] ", idx);
           error |= dwg_decode_eed_data (dat, obj->eed[idx].data, end, size);
           // overflow or no advance
@@ -3853,7 +3870,7 @@ dwg_decode_eed (Bit_Chain *restrict dat, Dwg_Object_Object *restrict obj)
             error |= DWG_ERR_INVALIDEED;
           if (error & DWG_ERR_INVALIDEED)
             {
-              free (obj->eed[idx].data);
+              dwg_free_mem (obj->eed[idx].data);
               LOG_HANDLE ("        invalid eed[%d]: skip", idx);
               LOG_RPOS
               obj->eed[idx].data = NULL;
@@ -3878,8 +3895,8 @@ dwg_decode_eed (Bit_Chain *restrict dat, Dwg_Object_Object *restrict obj)
               size = (long)(end - dat->byte + 1);
               // LOG_INSANE ("        size remaining: %ld\n", (long)size);
               // LOG_RPOS
-              obj->eed = (Dwg_Eed *)realloc (obj->eed,
-                                             obj->num_eed * sizeof (Dwg_Eed));
+              obj->eed = (Dwg_Eed *)dwg_realloc (
+                  obj->eed, obj->num_eed * sizeof (Dwg_Eed));
               obj->eed[idx].handle = obj->eed[idx - 1].handle;
               obj->eed[idx].size = 0;
               obj->eed[idx].raw = NULL;
@@ -4368,7 +4385,8 @@ dwg_decode_add_object_ref (Dwg_Data *restrict dwg, Dwg_Object_Ref *ref)
 EXPORT Dwg_Object_Ref *
 dwg_new_ref (Dwg_Data *restrict dwg)
 {
-  Dwg_Object_Ref *ref = (Dwg_Object_Ref *)calloc (1, sizeof (Dwg_Object_Ref));
+  Dwg_Object_Ref *ref
+      = (Dwg_Object_Ref *)dwg_calloc (1, sizeof (Dwg_Object_Ref));
   if (!ref)
     {
       LOG_ERROR ("Out of memory");
@@ -4376,7 +4394,7 @@ dwg_new_ref (Dwg_Data *restrict dwg)
     }
   if (dwg_decode_add_object_ref (dwg, ref))
     {
-      free (ref);
+      dwg_free_mem (ref);
       LOG_INSANE ("dwg_decode_add_object_ref failed " FORMAT_BL "\n",
                   dwg->num_object_refs);
       return NULL;
@@ -4391,7 +4409,8 @@ dwg_decode_handleref (Bit_Chain *restrict dat, Dwg_Object *restrict obj,
                       Dwg_Data *restrict dwg)
 {
   // Welcome to the house of evil code
-  Dwg_Object_Ref *ref = (Dwg_Object_Ref *)calloc (1, sizeof (Dwg_Object_Ref));
+  Dwg_Object_Ref *ref
+      = (Dwg_Object_Ref *)dwg_calloc (1, sizeof (Dwg_Object_Ref));
   if (!ref)
     {
       LOG_ERROR ("Out of memory");
@@ -4399,7 +4418,7 @@ dwg_decode_handleref (Bit_Chain *restrict dat, Dwg_Object *restrict obj,
     }
   if (bit_read_H (dat, &ref->handleref))
     {
-      free (ref);
+      dwg_free_mem (ref);
       return NULL;
     }
 
@@ -4409,7 +4428,7 @@ dwg_decode_handleref (Bit_Chain *restrict dat, Dwg_Object *restrict obj,
     {
       if (dwg_decode_add_object_ref (dwg, ref))
         {
-          free (ref);
+          dwg_free_mem (ref);
           return NULL;
         }
     }
@@ -4417,7 +4436,7 @@ dwg_decode_handleref (Bit_Chain *restrict dat, Dwg_Object *restrict obj,
     {
       if (obj)
         {
-          free (ref);
+          dwg_free_mem (ref);
           return NULL;
         }
       ref->absolute_ref = 0;
@@ -4506,7 +4525,8 @@ dwg_decode_handleref_with_code (Bit_Chain *restrict dat,
                                 Dwg_Data *restrict dwg, unsigned int code)
 {
   int err;
-  Dwg_Object_Ref *ref = (Dwg_Object_Ref *)calloc (1, sizeof (Dwg_Object_Ref));
+  Dwg_Object_Ref *ref
+      = (Dwg_Object_Ref *)dwg_calloc (1, sizeof (Dwg_Object_Ref));
   if (!ref)
     {
       LOG_ERROR ("Out of memory");
@@ -4514,7 +4534,7 @@ dwg_decode_handleref_with_code (Bit_Chain *restrict dat,
     }
   if (bit_read_H (dat, &ref->handleref))
     {
-      free (ref);
+      dwg_free_mem (ref);
       return NULL;
     }
 
@@ -4526,7 +4546,7 @@ dwg_decode_handleref_with_code (Bit_Chain *restrict dat,
     {
       if (dwg_decode_add_object_ref (dwg, ref))
         {
-          free (ref);
+          dwg_free_mem (ref);
           return NULL;
         }
     }
@@ -4534,7 +4554,7 @@ dwg_decode_handleref_with_code (Bit_Chain *restrict dat,
     {
       /*if (obj)
         {
-          free (ref);
+          dwg_free_mem (ref);
           return NULL;
         }
       */
@@ -4644,8 +4664,8 @@ dwg_free_xdata_resbuf (Dwg_Resbuf *rbuf)
       Dwg_Resbuf *next = rbuf->nextrb;
       short type = dwg_resbuf_value_type (rbuf->type);
       if (type == DWG_VT_STRING || type == DWG_VT_BINARY)
-        free (rbuf->value.str.u.data);
-      free (rbuf);
+        dwg_free_mem (rbuf->value.str.u.data);
+      dwg_free_mem (rbuf);
       rbuf = next;
     }
 }
@@ -4685,7 +4705,7 @@ dwg_decode_xdata (Bit_Chain *restrict dat, Dwg_Object_XRECORD *restrict obj,
   while (dat->byte < end_address)
     {
       enum RESBUF_VALUE_TYPE vtype;
-      rbuf = (Dwg_Resbuf *)calloc (1, sizeof (Dwg_Resbuf));
+      rbuf = (Dwg_Resbuf *)dwg_calloc (1, sizeof (Dwg_Resbuf));
       if (!rbuf)
         {
           LOG_ERROR ("Out of memory");
@@ -4699,14 +4719,14 @@ dwg_decode_xdata (Bit_Chain *restrict dat, Dwg_Object_XRECORD *restrict obj,
       if (dat->byte == curr_address || dat->byte >= end_address)
         {
           // no advance, by dat overflow
-          free (rbuf);
+          dwg_free_mem (rbuf);
           dat->byte = end_address;
           break;
         }
       if (rbuf->type < 0 || rbuf->type >= 2000)
         {
           LOG_ERROR ("Invalid xdata type %d [RS]", rbuf->type);
-          free (rbuf);
+          dwg_free_mem (rbuf);
           dat->byte = end_address;
           break;
         }
@@ -4735,7 +4755,8 @@ dwg_decode_xdata (Bit_Chain *restrict dat, Dwg_Object_XRECORD *restrict obj,
             length = bit_read_RS (dat);
             if ((short)length > 0 && dat->byte + (length * 2) <= end_address)
               {
-                rbuf->value.str.u.wdata = (BITCODE_TU)calloc (length + 1, 2);
+                rbuf->value.str.u.wdata
+                    = (BITCODE_TU)dwg_calloc (length + 1, 2);
                 if (!rbuf->value.str.u.wdata)
                   {
                     LOG_ERROR ("Out of memory");
@@ -4745,7 +4766,7 @@ dwg_decode_xdata (Bit_Chain *restrict dat, Dwg_Object_XRECORD *restrict obj,
                       {
                         dwg_free_xdata_resbuf (root);
                         if (rbuf)
-                          free (rbuf);
+                          dwg_free_mem (rbuf);
                       }
                     else
                       dwg_free_xdata_resbuf (rbuf);
@@ -5119,6 +5140,15 @@ dwg_decode_add_object (Dwg_Data *restrict dwg, Bit_Chain *dat,
   int error = 0;
   int realloced = 0;
 
+  /* all previous objects are complete, and may be emitted */
+  if (dwg->decode_hook)
+    {
+      // the hook allocates from the heap
+      Dwg_Arena *arena = dwg_arena_use (NULL);
+      dwg->decode_hook (dwg, num, dwg->decode_hook_arg);
+      dwg_arena_use (arena);
+    }
+
   /* Keep the previous full chain  */
   abs_dat = *dat;
 
@@ -5578,6 +5608,15 @@ dwg_decode_add_object (Dwg_Data *restrict dwg, Bit_Chain *dat,
   bit_set_position (dat, (obj->address + obj->size) * 8 - 2);
   if (!bit_check_CRC (dat, address, 0xC0C1))
     error |= DWG_ERR_WRONGCRC;
+  /* Keep the bits of valid objects, to be copied by an unchanged
+     re-encode */
+  else if (dwg->opts & DWG_OPTS_KEEPRAW && error < DWG_ERR_CRITICAL
+           && obj->size)
+    {
+      obj->raw = (BITCODE_TF)dwg_malloc (obj->size);
+      if (obj->raw)
+        memcpy (obj->raw, &dat->chain[obj->address], obj->size);
+    }
 
   /* Reset to previous addresses for return */
   *dat = abs_dat;
@@ -5749,8 +5788,8 @@ dwg_validate_POLYLINE (Dwg_Object *restrict obj)
                   dwg, next); // usually not found, even with set hash
               if (seqend == NULL)
                 {
-                  seqend
-                      = (Dwg_Object_Ref *)calloc (1, sizeof (Dwg_Object_Ref));
+                  seqend = (Dwg_Object_Ref *)dwg_calloc (
+                      1, sizeof (Dwg_Object_Ref));
                   seqend->obj = next;
                   seqend->handleref = next->handle;
                   seqend->absolute_ref = next->handle.value;
@@ -5770,7 +5809,7 @@ dwg_validate_POLYLINE (Dwg_Object *restrict obj)
                       seqend = dwg_find_objectref (dwg, next);
                       if (seqend == NULL)
                         {
-                          seqend = (Dwg_Object_Ref *)calloc (
+                          seqend = (Dwg_Object_Ref *)dwg_calloc (
                               1, sizeof (Dwg_Object_Ref));
                           seqend->obj = next;
                           seqend->handleref = next->handle;
@@ -5892,7 +5931,7 @@ dwg_fixup_BLOCKS_entities (Dwg_Data *restrict dwg)
                              _objname, j, o->name);
                   changes++;
                   if (is_uni)
-                    free (_objname);
+                    dwg_free_mem (_objname);
                   continue;
                 }
               // only log changes
@@ -6006,7 +6045,7 @@ dwg_fixup_BLOCKS_entities (Dwg_Data *restrict dwg)
                 }
             }
           if (is_uni)
-            free (_objname);
+            dwg_free_mem (_objname);
         }
     }
   LOG_TRACE ("\n");
@@ -6295,7 +6334,7 @@ decode_preR13_sentinel (const Dwg_Sentinel sentinel,
           error = DWG_ERR_WRONGCRC;
         }
     }
-  free (r11_sentinel);
+  dwg_free_mem (r11_sentinel);
 
   return error;
 }
@@ -6940,7 +6979,8 @@ decode_preR13_entities (BITCODE_RL start, BITCODE_RL end,
                               = (BITCODE_RL)(obj->address + obj->size
                                              - dat->byte);
                           obj->num_unknown_rest = 8 * offset;
-                          obj->unknown_rest = (BITCODE_TF)calloc (offset, 1);
+                          obj->unknown_rest
+                              = (BITCODE_TF)dwg_calloc (offset, 1);
                           if (obj->unknown_rest)
                             {
                               memcpy (obj->unknown_rest,
@@ -48,6 +48,7 @@ char *basename (char *);
 #  include "encode.h"
 #endif
 #include "free.h"
+#include "snapshot.h"
 
 /* The logging level per .o */
 static unsigned int loglevel;
@@ -217,11 +218,17 @@ dwg_read_file (const char *restrict filename, Dwg_Data *restrict dwg)
   FILE *fp;
   struct_stat_t attrib;
   Bit_Chain bit_chain = { 0 };
+  Dwg_Decode_Hook decode_hook = dwg->decode_hook;
+  void *decode_hook_arg = dwg->decode_hook_arg;
+  const unsigned int keep
+      = dwg->opts & (DWG_OPTS_KEEPRAW | DWG_OPTS_ARENA);
   int error;
 
   loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
   memset (dwg, 0, sizeof (Dwg_Data));
-  dwg->opts = loglevel;
+  dwg->opts = loglevel | keep;
+  dwg->decode_hook = decode_hook;
+  dwg->decode_hook_arg = decode_hook_arg;
 
   if (strEQc (filename, "-"))
     {
@@ -271,8 +278,11 @@ dwg_read_file (const char *restrict filename, Dwg_Data *restrict dwg)
     }
   fclose (fp);
 
-  /* Decode the dwg structure */
-  error = dwg_decode (&bit_chain, dwg);
+  /* Decode the dwg structure, or restore it from a snapshot */
+  if (dwg_is_snapshot (&bit_chain))
+    error = dwg_decode_snapshot (&bit_chain, dwg);
+  else
+    error = dwg_decode (&bit_chain, dwg);
   if (error >= DWG_ERR_CRITICAL)
     {
       LOG_ERROR ("Failed to decode file: %s 0x%x\n", filename, error)
@@ -291,6 +301,95 @@ dwg_read_file (const char *restrict filename, Dwg_Data *restrict dwg)
   return error;
 }
 
+/** dwg_read_snapshot
+ * returns 0 on success.
+ *
+ * Restores dwg from a snapshot written by dwg_write_snapshot, by the
+ * same library version on the same platform. Other files are rejected.
+ * The result is freed with dwg_free as usual.
+ */
+EXPORT int
+dwg_read_snapshot (const char *restrict filename, Dwg_Data *restrict dwg)
+{
+  FILE *fp;
+  Bit_Chain bit_chain = { 0 };
+  const unsigned int opts = dwg->opts;
+  Dwg_Decode_Hook decode_hook = dwg->decode_hook;
+  void *decode_hook_arg = dwg->decode_hook_arg;
+  int error;
+
+  loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
+  memset (dwg, 0, sizeof (Dwg_Data));
+  dwg->opts = opts & DWG_OPTS_LOGLEVEL;
+  dwg->decode_hook = decode_hook;
+  dwg->decode_hook_arg = decode_hook_arg;
+
+  fp = fopen (filename, "rb");
+  if (!fp)
+    {
+      LOG_ERROR ("Could not open file: %s\n", filename)
+      return DWG_ERR_IOERROR;
+    }
+  bit_chain.opts = dwg->opts;
+  error = dat_read_file (&bit_chain, fp, filename);
+  if (error >= DWG_ERR_CRITICAL)
+    return error;
+  fclose (fp);
+  if (!dwg_is_snapshot (&bit_chain))
+    {
+      LOG_ERROR ("Not a snapshot: %s\n", filename)
+      free (bit_chain.chain);
+      return DWG_ERR_INVALIDDWG;
+    }
+  error = dwg_decode_snapshot (&bit_chain, dwg);
+  if (error >= DWG_ERR_CRITICAL)
+    LOG_ERROR ("Failed to restore snapshot: %s 0x%x\n", filename, error)
+  free (bit_chain.chain);
+  return error;
+}
+
+/** dwg_write_snapshot
+ * returns 0 on success.
+ *
+ * Writes a binary image of the decoded dwg to filename, replacing it.
+ * Restoring it with dwg_read_snapshot or dwg_read_file skips the
+ * decoding. R13+ DWG input only, not imported DXF or JSON.
+ */
+EXPORT int
+dwg_write_snapshot (const char *restrict filename, Dwg_Data *restrict dwg)
+{
+  FILE *fh;
+  Bit_Chain dat = { 0 };
+  int error;
+
+  loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
+  dat.opts = dwg->opts;
+  dat.version = (Dwg_Version_Type)dwg->header.version;
+  dat.from_version = (Dwg_Version_Type)dwg->header.from_version;
+  error = dwg_encode_snapshot (&dat, dwg);
+  if (error >= DWG_ERR_CRITICAL)
+    {
+      LOG_ERROR ("Failed to write the snapshot\n")
+      free (dat.chain);
+      return error;
+    }
+  fh = fopen (filename, "wb");
+  if (!fh)
+    {
+      LOG_ERROR ("Failed to create the file: %s\n", filename)
+      free (dat.chain);
+      return error | DWG_ERR_IOERROR;
+    }
+  if (fwrite (dat.chain, sizeof (char), dat.byte, fh) != dat.byte)
+    {
+      LOG_ERROR ("Failed to write data into the file: %s\n", filename)
+      error |= DWG_ERR_IOERROR;
+    }
+  fclose (fh);
+  free (dat.chain);
+  return error;
+}
+
 #if !defined(DISABLE_DXF) && defined(USE_WRITE)
 /** dxf_read_file
  * returns 0 on success.
@@ -308,6 +407,7 @@ dxf_read_file (const char *restrict filename, Dwg_Data *restrict dwg)
   size_t size;
   Bit_Chain dat = { 0 };
   Dwg_Version_Type version;
+  unsigned int stream;
 
   loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
 
@@ -332,14 +432,33 @@ dxf_read_file (const char *restrict filename, Dwg_Data *restrict dwg)
       return DWG_ERR_IOERROR;
     }
 
-  /* Load whole file into memory
-   */
   version = dwg->header.version;
+  stream = dwg->opts & DWG_OPTS_STREAM;
   memset (dwg, 0, sizeof (Dwg_Data));
-  dwg->opts = loglevel | DWG_OPTS_INDXF;
+  dwg->opts = loglevel | DWG_OPTS_INDXF | stream;
   dwg->header.version = version;
 
   memset (&dat, 0, sizeof (Bit_Chain));
+  /* Read through a small window, detecting binary DXF in dwg_read_dxf */
+  if (stream)
+    {
+      dat.fh = fp;
+      dat.from_version = dwg->header.from_version;
+      dat.version = dwg->header.version;
+      dat.opts = dwg->opts;
+      error = dwg_read_dxf (&dat, dwg);
+      fclose (fp);
+      dwg->opts |= (DWG_OPTS_INDXF | loglevel);
+      if (error >= DWG_ERR_CRITICAL)
+        {
+          LOG_ERROR ("Failed to decode DXF file: %s\n", filename)
+          return error;
+        }
+      return 0;
+    }
+
+  /* Load whole file into memory
+   */
 #  ifdef HAVE_SYS_STAT_H
   dat.size = attrib.st_size;
 #  endif
@@ -515,6 +634,84 @@ dwg_write_file (const char *restrict filename, const Dwg_Data *restrict dwg)
 
   return error;
 }
+
+/** dwg_write_incremental
+ * returns 0 on success.
+ *
+ * Saves the changes to filename, which must be the r13-r2000 DWG the dwg
+ * was read from, with DWG_OPTS_KEEPRAW and without a version change.
+ * Unchanged objects stay where they are. Changed and new objects, the
+ * header variables, classes, object map and the other sections are
+ * appended, and the file header is written last. The old copies are left
+ * as unused space, as with the ISAVEPERCENT saves of AutoCAD.
+ */
+EXPORT int
+dwg_write_incremental (const char *restrict filename, Dwg_Data *restrict dwg)
+{
+  FILE *fh;
+  Bit_Chain dat = { 0 };
+  size_t size, header_size;
+  int error;
+
+  loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
+  assert (filename);
+  assert (dwg);
+  if (dwg->header.version != dwg->header.from_version
+      || dwg->header.version < R_13b1 || dwg->header.version > R_2000)
+    {
+      LOG_ERROR ("Incremental saves only for r13-r2000, as the same version")
+      return DWG_ERR_INVALIDDWG;
+    }
+  fh = fopen (filename, "r+b");
+  if (!fh)
+    {
+      LOG_ERROR ("Could not open file: %s\n", filename)
+      return DWG_ERR_IOERROR;
+    }
+  dat.opts = dwg->opts;
+  dat.version = (Dwg_Version_Type)dwg->header.version;
+  dat.from_version = (Dwg_Version_Type)dwg->header.from_version;
+  dat.codepage = dwg->header.codepage;
+  error = dat_read_file (&dat, fh, filename);
+  if (error >= DWG_ERR_CRITICAL)
+    return error;
+  size = dat.size;
+  if (size < 0x80
+      || memcmp (dat.chain, dwg_version_codes (dwg->header.version), 6))
+    {
+      LOG_ERROR ("Not the %s DWG it was read from: %s\n",
+                 dwg_version_type (dwg->header.version), filename)
+      fclose (fh);
+      free (dat.chain);
+      return DWG_ERR_INVALIDDWG;
+    }
+
+  dwg->opts |= DWG_OPTS_INCREMENTAL;
+  error = dwg_encode (dwg, &dat);
+  dwg->opts &= ~DWG_OPTS_INCREMENTAL;
+  if (error >= DWG_ERR_CRITICAL || dat.size < size)
+    {
+      LOG_ERROR ("Failed to encode Dwg_Data\n");
+      fclose (fh);
+      free (dat.chain);
+      return error | DWG_ERR_INVALIDDWG;
+    }
+
+  // First the appended sections, then the file header which points to them
+  header_size = 0x19 + (dwg->header.sections * 9) + 2 + 16;
+  if (fseek (fh, (long)size, SEEK_SET)
+      || fwrite (&dat.chain[size], sizeof (char), dat.size - size, fh)
+             != dat.size - size
+      || fflush (fh) || fseek (fh, 0L, SEEK_SET)
+      || fwrite (dat.chain, sizeof (char), header_size, fh) != header_size)
+    {
+      LOG_ERROR ("Failed to write data into the file: %s\n", filename)
+      error |= DWG_ERR_IOERROR;
+    }
+  fclose (fh);
+  free (dat.chain);
+  return error;
+}
 #endif /* USE_WRITE */
 
 /* THUMBNAIL IMAGE DATA (R13C3+).
@@ -1721,6 +1918,19 @@ dwg_obj_is_acsh (const Dwg_Object *obj)
               || type == DWG_TYPE_ACSH_WEDGE_CLASS));
 }
 
+EXPORT void
+dwg_object_set_dirty (Dwg_Object *obj)
+{
+  if (!obj)
+    return;
+  obj->dirty = 1;
+  if (obj->raw)
+    {
+      dwg_owned_free (obj->parent ? obj->parent->arena : NULL, obj->raw);
+      obj->raw = NULL;
+    }
+}
+
 EXPORT Dwg_Section_Type
 dwg_section_type (const char *restrict name)
 {
@@ -1650,7 +1650,7 @@ DWG_ENTITY_END
         char *blockname = dwg_dim_blockname (dwg, obj);                       \
         VALUE_TV0 (blockname, 2);                                             \
         if (blockname)                                                        \
-          free (blockname);                                                   \
+          dwg_free_mem (blockname);                                           \
         FIELD_3BD (def_pt, 10);                                               \
       }                                                                       \
       else { FIELD_3BD (extrusion, 210); }                                    \
@@ -2743,9 +2743,9 @@ static int decode_3dsolid (Bit_Chain* dat, Bit_Chain* hdl_dat,
           do
             {
               FIELD_VALUE (encr_sat_data) = (char**)
-                realloc (FIELD_VALUE (encr_sat_data), (i+1) * sizeof (char*));
+                dwg_realloc (FIELD_VALUE (encr_sat_data), (i+1) * sizeof (char*));
               FIELD_VALUE (block_size) = (BITCODE_BL*)
-                realloc (FIELD_VALUE (block_size), (i+1) * sizeof (BITCODE_BL));
+                dwg_realloc (FIELD_VALUE (block_size), (i+1) * sizeof (BITCODE_BL));
               if (!FIELD_VALUE (encr_sat_data) || !FIELD_VALUE (block_size))
                 return DWG_ERR_OUTOFMEM;
               FIELD_BL (block_size[i], 0);
@@ -2761,20 +2761,20 @@ static int decode_3dsolid (Bit_Chain* dat, Bit_Chain* hdl_dat,
                 }
               else
                 {
-                  FIELD_VALUE (encr_sat_data[i]) = (char*)calloc (1, 1);
+                  FIELD_VALUE (encr_sat_data[i]) = (char*)dwg_calloc (1, 1);
                   FIELD_VALUE (block_size[i]) = 0;
                 }
             }
           while (FIELD_VALUE (block_size[i++]) > 0 && AVAIL_BITS (dat) >= 16); // crc RS
           if (!FIELD_VALUE (encr_sat_data) || !FIELD_VALUE (block_size))
             {
-              free (FIELD_VALUE (block_size));
-              free (FIELD_VALUE (encr_sat_data));
+              dwg_free_mem (FIELD_VALUE (block_size));
+              dwg_free_mem (FIELD_VALUE (encr_sat_data));
               return DWG_ERR_VALUEOUTOFBOUNDS;
             }
 
           // de-obfuscate SAT data
-          FIELD_VALUE (acis_data) = (BITCODE_RC *)malloc (total_size + 1);
+          FIELD_VALUE (acis_data) = (BITCODE_RC *)dwg_malloc (total_size + 1);
           num_blocks = i - 1;
           FIELD_VALUE (num_blocks) = num_blocks;
           LOG_TRACE ("num_blocks: " FORMAT_BL "\n", FIELD_VALUE (num_blocks));
@@ -2811,7 +2811,7 @@ static int decode_3dsolid (Bit_Chain* dat, Bit_Chain* hdl_dat,
            R?? (2018) release            223.0.1.1930
         */
         {
-          FIELD_VALUE (block_size) = (BITCODE_BL*)calloc (2, sizeof (BITCODE_BL));
+          FIELD_VALUE (block_size) = (BITCODE_BL*)dwg_calloc (2, sizeof (BITCODE_BL));
           FIELD_VALUE (encr_sat_data) = NULL;
           //TODO string in strhdl, even <r2007
           // either has_ds_data (r2013+) or the blob is here
@@ -2823,7 +2823,7 @@ static int decode_3dsolid (Bit_Chain* dat, Bit_Chain* hdl_dat,
               const char end1[] = "\016\003End\016\002of\016\003ASM\r\004data";
               size_t pos = dat->byte;
               size_t size = dat->size - pos - 1;
-              FIELD_VALUE (acis_data) = (unsigned char*)calloc (size, 1);
+              FIELD_VALUE (acis_data) = (unsigned char*)dwg_calloc (size, 1);
               // Binary SAB. unencrypted, documented format until "End-of-ACIS-data"
               // TODO There exist also SAB streams with a given number of records, but I
               // haven't seen them here. See dwg_convert_SAB_to_SAT1
@@ -2905,7 +2905,7 @@ encode_3dsolid (Bit_Chain *dat, Bit_Chain *hdl_dat, Dwg_Object *restrict obj,
                 }
               // Later split into 4096 byte sized blocks
               FIELD_VALUE (block_size)
-                  = (BITCODE_BL *)calloc (2, sizeof (BITCODE_BL));
+                  = (BITCODE_BL *)dwg_calloc (2, sizeof (BITCODE_BL));
               FIELD_VALUE (block_size[0])
                   = strlen ((char *)FIELD_VALUE (acis_data)) & 0xFFFFFFFF;
               FIELD_VALUE (block_size[1]) = 0;
@@ -2944,7 +2944,7 @@ encode_3dsolid (Bit_Chain *dat, Bit_Chain *hdl_dat, Dwg_Object *restrict obj,
           /*
           if (num_blocks > FIELD_VALUE (num_blocks))
             {
-              FIELD_VALUE (block_size) = (BITCODE_BL*)realloc (FIELD_VALUE (block_size), (num_blocks + 1) * sizeof (BITCODE_BL));
+              FIELD_VALUE (block_size) = (BITCODE_BL*)dwg_realloc (FIELD_VALUE (block_size), (num_blocks + 1) * sizeof (BITCODE_BL));
               FIELD_VALUE (num_blocks) = num_blocks;
             }
           */
@@ -3235,7 +3235,7 @@ DWG_OBJECT (DICTIONARY)
       {
         FIRSTPREFIX
         VALUE_T (_obj->texts[rcount1]);
-        fprintf (dat->fh, ":%s", JSON_SPC);
+        out_printf (dat, ":%s", JSON_SPC);
         VALUE_HANDLE (_obj->itemhandles[rcount1], itemhandles, 2, 350);
       }
   }
@@ -3285,7 +3285,7 @@ DWG_OBJECT (DICTIONARYWDFLT)
       {
         FIRSTPREFIX
         VALUE_T (_obj->texts[rcount1]);
-        fprintf (dat->fh, ":%s", JSON_SPC);
+        out_printf (dat, ":%s", JSON_SPC);
         VALUE_HANDLE (_obj->itemhandles[rcount1], itemhandles, 2, 350);
       }
   }
@@ -3922,7 +3922,7 @@ DWG_TABLE (STYLE)
           if (IS_FROM_TU (dat)) {
             s = bit_convert_TU ((BITCODE_TU)FIELD_VALUE (font_file));
             strncpy (_buf, s, 255);
-            free (s);
+            dwg_free_mem (s);
           }
           else {
             strncpy (_buf, FIELD_VALUE (font_file), 255);
@@ -7442,14 +7442,14 @@ DWG_OBJECT (XRECORD)
       for (vcount=0; bit_position (hdl_dat) < obj->handlestream_size; vcount++)
         {
           FIELD_VALUE (objid_handles) = vcount
-            ? (BITCODE_H*)realloc (FIELD_VALUE (objid_handles),
-                                   (vcount+1) * sizeof (Dwg_Object_Ref))
-            : (BITCODE_H*)malloc (sizeof (Dwg_Object_Ref));
+            ? (BITCODE_H*)dwg_realloc (FIELD_VALUE (objid_handles),
+                                       (vcount+1) * sizeof (Dwg_Object_Ref))
+            : (BITCODE_H*)dwg_malloc (sizeof (Dwg_Object_Ref));
           FIELD_HANDLE_N (objid_handles[vcount], vcount, ANYCODE, 0);
           if (!FIELD_VALUE (objid_handles[vcount]))
             {
               if (!vcount) {
-                free (FIELD_VALUE (objid_handles));
+                dwg_free_mem (FIELD_VALUE (objid_handles));
                 FIELD_VALUE (objid_handles) = NULL;
               }
               break;
@@ -8026,7 +8026,7 @@ DWG_OBJECT (SECTION_SETTINGS)
           DECODER {
             if (bit_empty_T (dat, _obj->types[rcount1].geom[rcount2].hatch_pattern))
               {
-                free (_obj->types[rcount1].geom[rcount2].hatch_pattern);
+                dwg_free_mem (_obj->types[rcount1].geom[rcount2].hatch_pattern);
                 _obj->types[rcount1].geom[rcount2].hatch_pattern = bit_set_T (dat, "SOLID");
               }
           }
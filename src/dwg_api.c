@@ -58,6 +58,18 @@ static Dwg_Version_Type dwg_version = R_INVALID;
 static unsigned int loglevel = DWG_LOGLEVEL_ERROR;
 static unsigned nodeid = 0;
 
+// PUSH_HV onto a maybe decoded hvfield, owned by dwg->arena
+#define PUSH_OWNED_HV(dwg, _obj, numfield, hvfield, ref)                      \
+  {                                                                           \
+    _obj->hvfield = (BITCODE_H *)dwg_owned_realloc (                          \
+        dwg->arena, _obj->hvfield,                                            \
+        (_obj->numfield + 1) * sizeof (BITCODE_H));                           \
+    _obj->hvfield[_obj->numfield] = ref;                                      \
+    LOG_TRACE ("%s[%d] = " FORMAT_REF " [H]\n", #hvfield, _obj->numfield,     \
+               ARGS_REF (_obj->hvfield[_obj->numfield]));                     \
+    _obj->numfield++;                                                         \
+  }
+
 /* Non-public imports */
 /* I don't want to export these. */
 BITCODE_H dwg_find_tablehandle_silent (Dwg_Data *restrict dwg,
@@ -22225,11 +22237,14 @@ hdr_again:
 static void
 add_ent_reactor (Dwg_Object_Entity *obj, BITCODE_RLL absolute_ref)
 {
+  int error;
+  dwg_object_set_dirty (dwg_ent_to_object (obj, &error));
   if (obj->num_reactors)
     {
       obj->num_reactors++;
-      obj->reactors = (BITCODE_H *)realloc (
-          obj->reactors, obj->num_reactors * sizeof (BITCODE_H));
+      obj->reactors = (BITCODE_H *)dwg_owned_realloc (
+          obj->dwg->arena, obj->reactors,
+          obj->num_reactors * sizeof (BITCODE_H));
     }
   else
     {
@@ -22243,11 +22258,14 @@ add_ent_reactor (Dwg_Object_Entity *obj, BITCODE_RLL absolute_ref)
 static void
 add_obj_reactor (Dwg_Object_Object *obj, BITCODE_RLL absolute_ref)
 {
+  int error;
+  dwg_object_set_dirty (dwg_obj_obj_to_object (obj, &error));
   if (obj->num_reactors)
     {
       obj->num_reactors++;
-      obj->reactors = (BITCODE_H *)realloc (
-          obj->reactors, obj->num_reactors * sizeof (BITCODE_H));
+      obj->reactors = (BITCODE_H *)dwg_owned_realloc (
+          obj->dwg->arena, obj->reactors,
+          obj->num_reactors * sizeof (BITCODE_H));
     }
   else
     {
@@ -22474,7 +22492,7 @@ dwg_add_Document (Dwg_Data *restrict dwg, const int imperial)
   if (version > R_11) // also meter sometimes. unit1_text
     {
       if (dwg->header_vars.unit1_name)
-        free (dwg->header_vars.unit1_name);
+        dwg_owned_free (dwg->arena, dwg->header_vars.unit1_name);
       dwg->header_vars.unit1_name = dwg_add_u8_input (dwg, "m");
     }
   dwg->header_vars.DIMASO = 1;
@@ -22812,7 +22830,7 @@ dwg_add_Document (Dwg_Data *restrict dwg, const int imperial)
       block_control->num_entries--;
       if (!block_control->num_entries)
         {
-          free (block_control->entries);
+          dwg_owned_free (dwg->arena, block_control->entries);
           block_control->entries = NULL;
         }
       dwg->header_vars.BLOCK_RECORD_PSPACE
@@ -23103,6 +23121,7 @@ dwg_insert_entity (Dwg_Object_BLOCK_HEADER *restrict _owner,
   Dwg_Object_Entity *ent = obj->tio.entity;
 
   assert (mspace);
+  dwg_object_set_dirty (owner);
   // set entmode and ownerhandle
   if (owner->fixedtype == DWG_TYPE_BLOCK_HEADER
       && owner->handle.value == mspace->absolute_ref)
@@ -23155,7 +23174,7 @@ dwg_insert_entity (Dwg_Object_BLOCK_HEADER *restrict _owner,
           ref = dwg_add_handleref (dwg, 3, obj->handle.value, NULL);
           LOG_TRACE ("%s.entities[%d] = " FORMAT_REF "\n", owner->name,
                      _owner->num_owned, ARGS_REF (ref));
-          PUSH_HV (_owner, num_owned, entities, ref)
+          PUSH_OWNED_HV (dwg, _owner, num_owned, entities, ref)
           // ent->nolinks = 1;
           LOG_TRACE ("%s.num_owned = %u\n", owner->name, _owner->num_owned);
         }
@@ -23179,13 +23198,14 @@ dwg_insert_entity (Dwg_Object_BLOCK_HEADER *restrict _owner,
               ref = dwg_add_handleref (dwg, 3, obj->handle.value, NULL);
               LOG_TRACE ("%s.entities[%d] = " FORMAT_REF "\n", owner->name,
                          _owner->num_owned, ARGS_REF (ref));
-              PUSH_HV (_owner, num_owned, entities, ref)
+              PUSH_OWNED_HV (dwg, _owner, num_owned, entities, ref)
               LOG_TRACE ("%s.num_owned = %u\n", owner->name,
                          _owner->num_owned);
             }
           // link prev. last to curr last
           if (prev && prev->supertype == DWG_SUPERTYPE_ENTITY)
             {
+              dwg_object_set_dirty (prev);
               if (prev->index + 1 == obj->index && // immediate next
                   prev->tio.entity->prev_entity && // and pref exist
                   prev->tio.entity->prev_entity->absolute_ref)
@@ -23272,16 +23292,20 @@ add_attrib_links (Dwg_Object_BLOCK_HEADER *restrict blkhdr,
   else
     {
       Dwg_Data *dwg = insobj->parent;
+      dwg_object_set_dirty (insobj);
+      dwg_object_set_dirty (lastobj);
       insert->last_attrib
           = dwg_add_handleref (dwg, 4, attobj->handle.value, insobj);
       attobj->tio.entity->prev_entity = insert->last_attrib;
       insert->num_owned++;
-      insert->attribs = (BITCODE_H *)realloc (
-          insert->attribs, insert->num_owned * sizeof (BITCODE_H));
+      insert->attribs = (BITCODE_H *)dwg_owned_realloc (
+          dwg->arena, insert->attribs,
+          insert->num_owned * sizeof (BITCODE_H));
       lastobj->tio.entity->next_entity
           = dwg_add_handleref (dwg, 3, attobj->handle.value, insobj);
       insert->attribs[insert->num_owned - 1] = insert->last_attrib;
       seqend = dwg_ref_object (dwg, insert->seqend);
+      dwg_object_set_dirty (seqend);
       IN_POSTPROCESS_SEQEND (seqend, insert->num_owned, insert->attribs);
     }
   return insert;
@@ -23498,14 +23522,16 @@ dwg_add_INSERT (Dwg_Object_BLOCK_HEADER *restrict blkhdr,
         return _obj;
       _obj->block_header = dwg_add_handleref (dwg, 5, hdr->handle.value, NULL);
       blkhdr = hdr->tio.object->tio.BLOCK_HEADER;
+      dwg_object_set_dirty (hdr);
       blkhdr->used = 1;
       blkhdr->is_xref_ref = 1;
       blkhdr->num_inserts++;
       if (!blkhdr->inserts)
         blkhdr->inserts = (BITCODE_H *)calloc (1, sizeof (BITCODE_H));
       else
-        blkhdr->inserts = (BITCODE_H *)realloc (
-            blkhdr->inserts, blkhdr->num_inserts * sizeof (BITCODE_H));
+        blkhdr->inserts = (BITCODE_H *)dwg_owned_realloc (
+            dwg->arena, blkhdr->inserts,
+            blkhdr->num_inserts * sizeof (BITCODE_H));
       blkhdr->inserts[blkhdr->num_inserts - 1]
           = dwg_add_handleref (dwg, 4, obj->handle.value, NULL);
     }
@@ -23564,14 +23590,16 @@ dwg_add_MINSERT (Dwg_Object_BLOCK_HEADER *restrict blkhdr,
         return _obj;
       _obj->block_header = dwg_add_handleref (dwg, 5, hdr->handle.value, NULL);
       blkhdr = hdr->tio.object->tio.BLOCK_HEADER;
+      dwg_object_set_dirty (hdr);
       blkhdr->used = 1;
       blkhdr->is_xref_ref = 1;
       blkhdr->num_inserts++;
       if (!blkhdr->inserts)
         blkhdr->inserts = (BITCODE_H *)calloc (1, sizeof (BITCODE_H));
       else
-        blkhdr->inserts = (BITCODE_H *)realloc (
-            blkhdr->inserts, blkhdr->num_inserts * sizeof (BITCODE_H));
+        blkhdr->inserts = (BITCODE_H *)dwg_owned_realloc (
+            dwg->arena, blkhdr->inserts,
+            blkhdr->num_inserts * sizeof (BITCODE_H));
       blkhdr->inserts[blkhdr->num_inserts - 1]
           = dwg_add_handleref (dwg, 4, obj->handle.value, NULL);
     }
@@ -24834,6 +24862,7 @@ dwg_add_DICTIONARY_item (Dwg_Object_DICTIONARY *_obj, const char *restrict key,
       LOG_ERROR ("dwg_add_DICTIONARY_item: no obj from DICTIONARY");
       return NULL;
     }
+  dwg_object_set_dirty (obj);
   if (!_obj->numitems)
     {
       _obj->texts = (char **)calloc (1, sizeof (BITCODE_T));
@@ -24872,10 +24901,11 @@ dwg_add_DICTIONARY_item (Dwg_Object_DICTIONARY *_obj, const char *restrict key,
             }
         }
       // not found:
-      _obj->texts = (char **)realloc (_obj->texts, (_obj->numitems + 1)
-                                                       * sizeof (BITCODE_T));
-      _obj->itemhandles = (BITCODE_H *)realloc (
-          _obj->itemhandles, (_obj->numitems + 1) * sizeof (BITCODE_H));
+      _obj->texts = (char **)dwg_owned_realloc (
+          dwg->arena, _obj->texts, (_obj->numitems + 1) * sizeof (BITCODE_T));
+      _obj->itemhandles = (BITCODE_H *)dwg_owned_realloc (
+          dwg->arena, _obj->itemhandles,
+          (_obj->numitems + 1) * sizeof (BITCODE_H));
     }
 
   _obj->texts[_obj->numitems] = dwg_add_u8_input (dwg, key);
@@ -25287,10 +25317,12 @@ dwg_add_BLOCK_CONTROL (Dwg_Data *restrict dwg, const unsigned ms,
       ctrl = &dwg->object[ctrlidx];                                           \
       ctrl->size = 0;                                                         \
       ctrl->bitsize = 0;                                                      \
+      dwg_object_set_dirty (ctrl);                                            \
       __VA_ARGS__                                                             \
       if (_ctrl->entries)                                                     \
-        _ctrl->entries = (BITCODE_H *)realloc (                               \
-            _ctrl->entries, (_ctrl->num_entries + 1) * sizeof (BITCODE_H));   \
+        _ctrl->entries = (BITCODE_H *)dwg_owned_realloc (                     \
+            dwg->arena, _ctrl->entries,                                       \
+            (_ctrl->num_entries + 1) * sizeof (BITCODE_H));                   \
       else                                                                    \
         _ctrl->entries = (BITCODE_H *)calloc (_ctrl->num_entries + 1,         \
                                               sizeof (BITCODE_H));            \
@@ -28263,6 +28295,7 @@ dwg_add_SPATIAL_FILTER (
   dwg = ins ? ins->parent : NULL;
   if (!dwg || err)
     return NULL;
+  dwg_object_set_dirty (ins);
   {
     REQUIRE_CLASS ("SPATIAL_FILTER");
 
@@ -14021,6 +14021,12 @@ dwg_dynapi_header_field (const char *restrict fieldname)
               sizeof (_dwg_header_variables_fields[0]), _name_struct_cmp);
 }
 
+EXPORT const Dwg_DYNAPI_field *
+dwg_dynapi_header_fields (void)
+{
+  return _dwg_header_variables_fields;
+}
+
 EXPORT const Dwg_DYNAPI_field *
 dwg_dynapi_common_entity_field (const char *restrict fieldname)
 {
@@ -14393,6 +14399,7 @@ dwg_dynapi_common_utf8text(void *restrict _obj, const char *restrict fieldname,
 static void
 dynapi_set_helper (void *restrict old, const Dwg_DYNAPI_field *restrict f,
                    const Dwg_Version_Type dwg_version,
+                   const Dwg_Arena *arena,
                    const void *restrict value, const bool is_utf8)
 {
   // TODO: sanity checks. is_malloc (TF), copy zero's (TFv)
@@ -14410,7 +14417,7 @@ dynapi_set_helper (void *restrict old, const Dwg_DYNAPI_field *restrict f,
           char *str = (char *)calloc (f->size + 1, 1);
           strncpy (str, *(char**)value, f->size);
           // we copy just the pointer to heap-alloced str, not the string
-          free (*(char **)old);
+          dwg_owned_free (arena, *(char **)old);
           memcpy (old, &str, sizeof (char*)); // size of ptr
         }
       // ascii
@@ -14421,7 +14428,7 @@ dynapi_set_helper (void *restrict old, const Dwg_DYNAPI_field *restrict f,
           char *str = (char *)malloc (len + 1);
           memcpy (str, *(char**)value, len + 1);
           // we copy just the pointer, not the string
-          free (*(char **)old);
+          dwg_owned_free (arena, *(char **)old);
           memcpy (old, &str, sizeof (char*)); // size of ptr
         }
       // or wide
@@ -14444,7 +14451,7 @@ dynapi_set_helper (void *restrict old, const Dwg_DYNAPI_field *restrict f,
               memcpy (wstr, value, length * 2);
 #endif
             }
-          free (*(char **)old);
+          dwg_owned_free (arena, *(char **)old);
           memcpy (old, &wstr, sizeof (char*)); // size of ptr
         }
       else
@@ -14466,7 +14473,7 @@ dwg_dynapi_entity_set_value (void *restrict _obj, const char *restrict name,
 #endif
   {
     int error;
-    const Dwg_Object *obj = dwg_obj_generic_to_object (_obj, &error);
+    Dwg_Object *obj = dwg_obj_generic_to_object (_obj, &error);
     if (error)
       {
         const int loglevel = DWG_LOGLEVEL_ERROR;
@@ -14516,7 +14523,9 @@ dwg_dynapi_entity_set_value (void *restrict _obj, const char *restrict name,
             }
         }
       old = &((char*)_obj)[f->offset];
-      dynapi_set_helper (old, f, dwg_version, value, is_utf8);
+      dynapi_set_helper (old, f, dwg_version, dwg ? dwg->arena : NULL, value,
+                         is_utf8);
+      dwg_object_set_dirty (obj);
       return true;
     }
   }
@@ -14569,7 +14578,8 @@ dwg_dynapi_header_set_value (Dwg_Data *restrict dwg,
               }
           }
         old = &((char*)_obj)[f->offset];
-        dynapi_set_helper (old, f, dwg->header.version, value, is_utf8);
+        dynapi_set_helper (old, f, dwg->header.version, dwg->arena, value,
+                           is_utf8);
 
         // Set also FLAGS
         if (strEQc (fieldname, "CELWEIGHT"))
@@ -14621,7 +14631,7 @@ dwg_dynapi_common_set_value (void *restrict _obj,
     Dwg_DYNAPI_field *f;
     int error;
     void *old;
-    const Dwg_Object *obj = dwg_obj_generic_to_object (_obj, &error);
+    Dwg_Object *obj = dwg_obj_generic_to_object (_obj, &error);
     Dwg_Data *dwg;
     if (!obj || error)
       {
@@ -14669,7 +14679,9 @@ dwg_dynapi_common_set_value (void *restrict _obj,
         memcpy (old, value, size);
       }
     else
-      dynapi_set_helper (old, f, dwg ? dwg->header.version : R_INVALID, value, is_utf8);
+      dynapi_set_helper (old, f, dwg ? dwg->header.version : R_INVALID,
+                         dwg ? dwg->arena : NULL, value, is_utf8);
+    dwg_object_set_dirty (obj);
 
     if (dwg && obj->supertype == DWG_SUPERTYPE_ENTITY && strEQc (fieldname, "ltype"))
       { // set also isbylayerlt and ltype_flags
@@ -14755,7 +14767,8 @@ dwg_dynapi_subclass_set_value (Dwg_Data *restrict dwg,
     }
   old = &((char*)ptr)[f->offset];
   if (f->is_string)
-    dynapi_set_helper (old, f, dwg->header.version, value, is_utf8);
+    dynapi_set_helper (old, f, dwg->header.version, dwg->arena, value,
+                       is_utf8);
   else
     memcpy (old, value, f->size);
   return true;
@@ -14789,7 +14802,8 @@ dwg_dynapi_field_set_value (const Dwg_Data *restrict dwg, /* only needed if unic
     return false;
 #endif
   off = &((char*)ptr)[field->offset];
-  dynapi_set_helper (off, field, dwg ? dwg->header.version : R_INVALID, value, is_utf8);
+  dynapi_set_helper (off, field, dwg ? dwg->header.version : R_INVALID,
+                     dwg ? dwg->arena : NULL, value, is_utf8);
   return true;
 }
 
@@ -58,6 +58,7 @@
 #include "classes.h"
 #include "dynapi.h"
 #include "free.h"
+#include "out_buf.h"
 
 // from dwg_api
 BITCODE_T dwg_add_u8_input (Dwg_Data *restrict dwg,
@@ -82,8 +83,8 @@ void dwg_upgrade_MLINESTYLE (Dwg_Data *restrict dwg,
 /* The logging level for the write (encode) path.  */
 static unsigned int loglevel;
 /* the current version per spec block */
-static Dwg_Version_Type cur_ver = R_INVALID;
-static BITCODE_BL rcount1 = 0, rcount2 = 0;
+static THREAD_LOCAL Dwg_Version_Type cur_ver = R_INVALID;
+static THREAD_LOCAL BITCODE_BL rcount1 = 0, rcount2 = 0;
 
 /* section_order: A static array of section types.
    SECTION_R13_SIZE is the size and the sentinel.
@@ -225,7 +226,7 @@ static bool env_var_checked_p;
     IF_ENCODE_FROM_EARLIER                                                    \
     {                                                                         \
       if (!_obj->nam)                                                         \
-        _obj->nam = strdup ("");                                              \
+        _obj->nam = (char *)dwg_calloc (1, 1);                                \
     }                                                                         \
     bit_write_TV (dat, _obj->nam);                                            \
     LOG_TRACE (#nam ": \"%s\" [TV %d]", _obj->nam, dxf);                      \
@@ -1431,11 +1432,11 @@ add_DUMMY_eed (Dwg_Object *obj)
       return 0;
     }
   ent->num_eed = 1;
-  ent->eed = (Dwg_Eed *)calloc (2, sizeof (Dwg_Eed));
+  ent->eed = (Dwg_Eed *)dwg_calloc (2, sizeof (Dwg_Eed));
   len = (int)strlen (name);
   size = is_tu ? 1 + 2 + (((len + 1) & 0xFFFF) * 2) // RC + RS_BE + wstr
                : 1 + 3 + (len & 0xFF) + 1;          // RC + RC+RS + str
-  data = ent->eed[0].data = (Dwg_Eed_Data *)calloc (size + 3, 1);
+  data = ent->eed[0].data = (Dwg_Eed_Data *)dwg_calloc (size + 3, 1);
   ent->eed[0].size = size;
   dwg_add_handle (&ent->eed[0].handle, 5, appid->absolute_ref, NULL);
   data->code = 0; // RC
@@ -1464,7 +1465,8 @@ add_DUMMY_eed (Dwg_Object *obj)
   size = ((len / 256) + 1) & 0xFFFF;
   if (size > 1) // we already reserved for two eeds
     {
-      ent->eed = (Dwg_Eed *)realloc (ent->eed, (1 + size) * sizeof (Dwg_Eed));
+      ent->eed
+          = (Dwg_Eed *)dwg_realloc (ent->eed, (1 + size) * sizeof (Dwg_Eed));
       memset (&ent->eed[1], 0, size * sizeof (Dwg_Eed));
     }
   do
@@ -1473,7 +1475,7 @@ add_DUMMY_eed (Dwg_Object *obj)
       ent->num_eed++;
       ent->eed[i].size = 0;
       ent->eed[0].size += l + 2;
-      data = ent->eed[i].data = (Dwg_Eed_Data *)calloc (l + 2, 1);
+      data = ent->eed[i].data = (Dwg_Eed_Data *)dwg_calloc (l + 2, 1);
       data->code = 4;           // RC
       data->u.eed_4.length = l; // also just an RC. max 256, how odd
       memcpy (data->u.eed_4.data, &obj->unknown_bits[off],
@@ -1530,9 +1532,9 @@ encode_unknown_as_dummy (Bit_Chain *restrict dat, Dwg_Object *restrict obj,
       if (dwg_supports_eed (dwg))
         add_DUMMY_eed (obj); // broken on windows
       dwg_free_object_private (obj);
-      free (obj->unknown_bits);
+      dwg_free_mem (obj->unknown_bits);
       obj->tio.entity->tio.POINT = _obj
-          = (Dwg_Entity_POINT *)realloc (_obj, sizeof (Dwg_Entity_POINT));
+          = (Dwg_Entity_POINT *)dwg_realloc (_obj, sizeof (Dwg_Entity_POINT));
       // memset (_obj, 0, sizeof (Dwg_Entity_POINT)); // asan cries
       _obj->parent = obj->tio.entity;
       _obj->x = 0.0;
@@ -1603,7 +1605,7 @@ encode_unknown_as_dummy (Bit_Chain *restrict dat, Dwg_Object *restrict obj,
         }
       else
         obj->dxfname = (char *)dxfname;
-      free (obj->unknown_bits);
+      dwg_free_mem (obj->unknown_bits);
     }
   obj->hdlpos = 0;
 }
@@ -1626,9 +1628,9 @@ remove_NOD_item (Dwg_Object_DICTIONARY *_obj, const int i, const char *name)
     return;
   if (i < last && _obj->itemhandles != NULL && _obj->texts != NULL)
     {
-      free (_obj->texts[i]);
+      dwg_free_mem (_obj->texts[i]);
       if (!_obj->itemhandles[i]->handleref.is_global)
-        free (_obj->itemhandles[i]);
+        dwg_free_mem (_obj->itemhandles[i]);
       memmove (&_obj->texts[i], &_obj->texts[i + 1],
                (last - i) * sizeof (BITCODE_T));
       memmove (&_obj->itemhandles[i], &_obj->itemhandles[i + 1],
@@ -2788,12 +2790,156 @@ encode_classes (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
   return error;
 }
 
+/* With an incremental save an unchanged object stays at its old address,
+   when its bits are still there. */
+static int
+encode_incremental_keep (const Dwg_Object *restrict obj,
+                         const Bit_Chain *restrict dat,
+                         const size_t append_address)
+{
+  return obj->raw && !obj->dirty && obj->size && obj->address > 4
+         && obj->address + obj->size + 2 <= append_address
+         && !memcmp (&dat->chain[obj->address], obj->raw, obj->size);
+}
+
+typedef struct _encode_objects_arg
+{
+  Dwg_Data *dwg;
+  Object_Map *omap;
+} Encode_Objects_Arg;
+
+/* Encodes the objects omap[from, to) into a private chain, and appends it
+   to dat. The object CRCs do not depend on the position, but the addresses
+   do: they are kept relative to the start of each object here, and
+   omap[].address holds the size of the object until
+   encode_objects_relocate(). */
+static int
+encode_objects_run (Bit_Chain *restrict dat, void *arg, BITCODE_BL from,
+                    BITCODE_BL to)
+{
+  Encode_Objects_Arg *ea = (Encode_Objects_Arg *)arg;
+  Dwg_Data *dwg = ea->dwg;
+  Object_Map *omap = ea->omap;
+  Bit_Chain run = EMPTY_CHAIN (0);
+  size_t size = 1;
+  int error = 0;
+  BITCODE_BL i;
+
+  for (i = from; i < to; i++)
+    if (omap[i].index < dwg->num_objects)
+      size += dwg->object[omap[i].index].size + 8;
+  bit_chain_init_dat (&run, size, dat);
+  if (!run.chain)
+    return DWG_ERR_OUTOFMEM;
+  run.byte = 1; // addresses must not be 0 before r2004
+  for (i = from; i < to; i++)
+    {
+      Dwg_Object *obj;
+      BITCODE_BL index = omap[i].index;
+      size_t start = run.byte;
+      size_t end_address;
+      if (!index && !omap[i].handle)
+        continue; // skipped objects
+      if (index >= dwg->num_objects)
+        {
+          LOG_ERROR ("Invalid object map index " FORMAT_BL ", max " FORMAT_BL
+                     ". Skipping",
+                     index, dwg->num_objects)
+          error |= DWG_ERR_VALUEOUTOFBOUNDS;
+          omap[i].address = 0;
+          continue;
+        }
+      obj = &dwg->object[index];
+      if (obj->type != DWG_TYPE_UNUSED && obj->type != DWG_TYPE_FREED)
+        {
+          if (!obj->parent)
+            obj->parent = dwg;
+          error |= dwg_encode_add_object (obj, &run, run.byte);
+          end_address = start + (size_t)obj->size;
+          if (end_address > run.size)
+            {
+              assert (obj->size < DWG_MAX_OBJSIZE);
+              bit_chain_alloc_size (&run, end_address - run.size);
+            }
+          obj->address -= start;
+          if (obj->bitsize_pos >= start * 8 && obj->bitsize_pos < run.byte * 8)
+            obj->bitsize_pos -= start * 8;
+          if (obj->hdlpos >= start * 8 && obj->hdlpos < run.byte * 8)
+            obj->hdlpos -= start * 8;
+        }
+      omap[i].address = run.byte - start;
+    }
+  out_write (dat, (const char *)&run.chain[1], run.byte - 1);
+  bit_chain_free (&run);
+  return error;
+}
+
+/* The final ordered pass: the runs are now concatenated at base,
+   so make all addresses absolute again. */
+static void
+encode_objects_relocate (Dwg_Data *restrict dwg, Object_Map *restrict omap,
+                         size_t base)
+{
+  size_t address = base;
+  BITCODE_BL i;
+  for (i = 0; i < dwg->num_objects; i++)
+    {
+      Dwg_Object *obj;
+      BITCODE_BL index = omap[i].index;
+      size_t size = omap[i].address;
+      if (!index && !omap[i].handle)
+        continue; // skipped objects
+      omap[i].address = address;
+      if (index >= dwg->num_objects)
+        continue;
+      obj = &dwg->object[index];
+      if (obj->type != DWG_TYPE_UNUSED && obj->type != DWG_TYPE_FREED)
+        {
+          obj->address += address;
+          if (obj->bitsize_pos < size * 8)
+            obj->bitsize_pos += address * 8;
+          if (obj->hdlpos < size * 8)
+            obj->hdlpos += address * 8;
+        }
+      address += size;
+    }
+}
+
+/* Encodes the sorted objects in worker threads, see out_render().
+   Runs of objects are encoded into memory, and appended in order. */
+static int
+encode_objects_threaded (Dwg_Data *restrict dwg, Bit_Chain *restrict dat,
+                         Object_Map *restrict omap)
+{
+  Encode_Objects_Arg ea;
+  Bit_Chain mem = *dat;
+  Out_Buf ob;
+  size_t base = dat->byte;
+  int error;
+
+  mem.fh = NULL;
+  out_buf_begin (&mem, &ob);
+  if (!mem.outbuf)
+    return DWG_ERR_OUTOFMEM;
+  // build the class map before, the workers only look it up
+  if (dwg->num_classes)
+    (void)dwg_class_index (dwg, "");
+  ea.dwg = dwg;
+  ea.omap = omap;
+  error = out_render (&mem, dwg, dwg->num_objects, encode_objects_run, &ea);
+  bit_write_TF (dat, (BITCODE_TF)ob.buf, ob.pos);
+  out_buf_end (&mem, &ob);
+  encode_objects_relocate (dwg, omap, base);
+  return error;
+}
+
 /*------------------------------------------------------------
  * Classes
  */
 static int
 encode_objects_handles (Dwg_Data *restrict dwg, Bit_Chain *restrict dat,
-                        Bit_Chain **restrict sec_dat)
+                        Bit_Chain **restrict sec_dat,
+                        const size_t append_address)
 {
   int error = 0;
   int ckr_missing = 1;
@@ -2878,68 +3024,86 @@ encode_objects_handles (Dwg_Data *restrict dwg, Bit_Chain *restrict dat,
 
   UNTIL (R_2002)
   {
-    dwg->objfreespace.objects_address = dat->byte & UINT32_MAX;
+    // appending keeps the old objects
+    if (!append_address)
+      dwg->objfreespace.objects_address = dat->byte & UINT32_MAX;
   }
   /* Write the sorted objects
    */
-  for (i = 0; i < dwg->num_objects; i++)
+  // the arena is not shared with the workers
+  if (dwg->opts & DWG_OPTS_THREADS && !(dwg->opts & DWG_OPTS_IN)
+      && !dwg->arena && !append_address && DWG_LOGLEVEL < DWG_LOGLEVEL_INFO)
+    error |= encode_objects_threaded (dwg, dat, omap);
+  else
     {
-      Dwg_Object *obj;
-      BITCODE_BL index = omap[i].index;
-      BITCODE_UMC hdloff = omap[i].handle - (i ? omap[i - 1].handle : 0);
-      BITCODE_MC off = (dat->byte - (i ? omap[i - 1].address : 0)) & INT32_MAX;
-      size_t end_address;
-      if (!index && !omap[i].handle)
-        continue; // skipped objects
-      LOG_TRACE ("\n> Next object: " FORMAT_BL " Handleoff: " FORMAT_UMC
-                 " [UMC] Offset: " FORMAT_MC " [MC] @%" PRIuSIZE "\n"
-                 "==========================================\n",
-                 i, hdloff, off, dat->byte);
-      omap[i].address = dat->byte;
-      if (index > dwg->num_objects)
-        {
-          LOG_ERROR ("Invalid object map index " FORMAT_BL ", max " FORMAT_BL
-                     ". Skipping",
-                     index, dwg->num_objects)
-          error |= DWG_ERR_VALUEOUTOFBOUNDS;
-          continue;
-        }
-      obj = &dwg->object[index];
-      if (obj->type == DWG_TYPE_UNUSED || obj->type == DWG_TYPE_FREED)
+      for (i = 0; i < dwg->num_objects; i++)
         {
-          continue;
-        }
-        // change the address to the linearly sorted one
+          Dwg_Object *obj;
+          BITCODE_BL index = omap[i].index;
+          BITCODE_UMC hdloff = omap[i].handle - (i ? omap[i - 1].handle : 0);
+          BITCODE_MC off
+              = (dat->byte - (i ? omap[i - 1].address : 0)) & INT32_MAX;
+          size_t end_address;
+          if (!index && !omap[i].handle)
+            continue; // skipped objects
+          LOG_TRACE ("\n> Next object: " FORMAT_BL " Handleoff: " FORMAT_UMC
+                     " [UMC] Offset: " FORMAT_MC " [MC] @%" PRIuSIZE "\n"
+                     "==========================================\n",
+                     i, hdloff, off, dat->byte);
+          omap[i].address = dat->byte;
+          if (index > dwg->num_objects)
+            {
+              LOG_ERROR ("Invalid object map index " FORMAT_BL
+                         ", max " FORMAT_BL ". Skipping",
+                         index, dwg->num_objects)
+              error |= DWG_ERR_VALUEOUTOFBOUNDS;
+              continue;
+            }
+          obj = &dwg->object[index];
+          if (obj->type == DWG_TYPE_UNUSED || obj->type == DWG_TYPE_FREED)
+            {
+              continue;
+            }
+          if (append_address
+              && encode_incremental_keep (obj, dat, append_address))
+            {
+              omap[i].address = obj->address - (obj->size > 0x7fff ? 4 : 2);
+              LOG_TRACE ("Kept at %" PRIuSIZE "\n", omap[i].address);
+              continue;
+            }
+            // change the address to the linearly sorted one
 #ifndef NDEBUG
-      PRE (R_2004a)
-      {
-        assert (dat->byte);
-      }
+          PRE (R_2004a)
+          {
+            assert (dat->byte);
+          }
 #endif
-      if (!obj->parent)
-        obj->parent = dwg;
-      error |= dwg_encode_add_object (obj, dat, dat->byte);
+          if (!obj->parent)
+            obj->parent = dwg;
+          error |= dwg_encode_add_object (obj, dat, dat->byte);
 
 #ifndef NDEBUG
-      // check if this object overwrote at address 0. but with r2004 it starts
-      // fresh.
-      if (dwg->header.version >= R_1_2 && dwg->header.version < R_2004)
-        {
-          if (dat->size < 6 || dat->chain[0] != 'A' || dat->chain[1] != 'C')
+          // check if this object overwrote at address 0. but with r2004 it
+          // starts fresh.
+          if (dwg->header.version >= R_1_2 && dwg->header.version < R_2004)
             {
-              LOG_ERROR ("Encode overwrite pos 0, invalid DWG magic");
-              return DWG_ERR_INVALIDDWG;
+              if (dat->size < 6 || dat->chain[0] != 'A'
+                  || dat->chain[1] != 'C')
+                {
+                  LOG_ERROR ("Encode overwrite pos 0, invalid DWG magic");
+                  return DWG_ERR_INVALIDDWG;
+                }
+              assert (dat->size > 6);
+              assert (dat->chain[0] == 'A');
+              assert (dat->chain[1] == 'C');
             }
-          assert (dat->size > 6);
-          assert (dat->chain[0] == 'A');
-          assert (dat->chain[1] == 'C');
-        }
 #endif
-      end_address = omap[i].address + (size_t)obj->size; // from RL
-      if (end_address > dat->size)
-        {
-          assert (obj->size < DWG_MAX_OBJSIZE);
-          bit_chain_alloc_size (dat, end_address - dat->size);
+          end_address = omap[i].address + (size_t)obj->size; // from RL
+          if (end_address > dat->size)
+            {
+              assert (obj->size < DWG_MAX_OBJSIZE);
+              bit_chain_alloc_size (dat, end_address - dat->size);
+            }
         }
     }
 
@@ -2990,7 +3154,8 @@ encode_objects_handles (Dwg_Data *restrict dwg, Bit_Chain *restrict dat,
                   index, handleoff, omap[i].handle)
       last_handle = omap[i].handle;
 
-      offset = (omap[i].address - last_offset) & INT32_MAX;
+      // negative after an incremental save
+      offset = (BITCODE_MC)((int64_t)omap[i].address - (int64_t)last_offset);
       bit_write_MC (dat, offset);
       last_offset = omap[i].address;
       LOG_HANDLE ("Offset: " FORMAT_MC " [MC] @%" PRIuSIZE "\n", offset,
@@ -3160,7 +3325,7 @@ encode_objfreespace_2ndheader (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
     {                                                                         \
       unsigned char chain[8];                                                 \
       Bit_Chain hdat                                                          \
-          = { chain, 8L, 0L, 0, 0, R_INVALID, R_INVALID, NULL, 30 };          \
+          = { chain, 8L, 0L, 0, 0, R_INVALID, R_INVALID, NULL, 30, NULL };    \
       bit_H_to_dat (&hdat, &dwg->header_vars.NAM->handleref);                 \
       _obj->handles[i].name = #NAM;                                           \
       for (int k = 0; k < MIN ((int)_obj->handles[i].num_hdl, 8); k++)        \
@@ -3205,12 +3370,13 @@ encode_objfreespace_2ndheader (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
  * Skip all MATERIAL objects, DICTS and common properties
  */
 AFL_GCC_TOOBIG
-EXPORT int
-dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
+static int
+encode_dwg (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
 {
   int error = 0;
   BITCODE_BL i, j;
   size_t section_address, header_crc_address = 0;
+  size_t append_address = 0;
   size_t pvzadr;
   unsigned int sec_size = 0;
   Bit_Chain *old_dat = NULL, *str_dat, *hdl_dat;
@@ -3338,6 +3504,9 @@ dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
         }
     }
 
+  // dwg_write_incremental: dat holds the old file, append the changes
+  if (dwg->opts & DWG_OPTS_INCREMENTAL && dat->chain)
+    append_address = dat->size;
   bit_chain_alloc (dat);
   hdl_dat = dat; // split later in objects/entities
   if (!dat->version)
@@ -3768,6 +3937,11 @@ dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
     header_crc_address = dat->byte;
     bit_write_CRC (dat, 0, 0xC0C1);
     write_sentinel (dat, DWG_SENTINEL_HEADER_END);
+    if (append_address)
+      {
+        LOG_INFO ("\n=======> Append at %" PRIuSIZE "\n", append_address);
+        dat->byte = append_address;
+      }
 
     VERSIONS (R_13b1, R_2000)
     {
@@ -3906,7 +4080,8 @@ dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
               break;
             case SECTION_HANDLES_R13:
               error
-                  |= encode_objects_handles (dwg, dat, (Bit_Chain **)&sec_dat);
+                  |= encode_objects_handles (dwg, dat, (Bit_Chain **)&sec_dat,
+                                             append_address);
               break;
             case SECTION_OBJFREESPACE_R13:
               error |= encode_objfreespace_2ndheader (dwg, dat);
@@ -3918,6 +4093,17 @@ dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
               error |= encode_auxheader (dwg, dat);
               break;
             case SECTION_THUMBNAIL_R13:
+              // an unchanged thumbnail stays in place
+              if (append_address && dwg->thumbnail.size
+                  && dwg->header.thumbnail_address + dwg->thumbnail.size + 32
+                         <= append_address
+                  && !memcmp (&dat->chain[dwg->header.thumbnail_address + 16],
+                              dwg->thumbnail.chain, dwg->thumbnail.size))
+                {
+                  LOG_TRACE ("Thumbnail kept at " FORMAT_RL "\n",
+                             dwg->header.thumbnail_address);
+                  break;
+                }
               error |= encode_r13_thumbnail (dwg, dat, header_crc_address);
               break;
             default:
@@ -3997,7 +4183,8 @@ dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
           case SECTION_HANDLES:
             bit_chain_init_dat (&sec_dat[type], 1000, dat);
             str_dat = hdl_dat = dat = &sec_dat[type];
-            error |= encode_objects_handles (dwg, dat, (Bit_Chain **)&sec_dat);
+            error |= encode_objects_handles (dwg, dat,
+                                             (Bit_Chain **)&sec_dat, 0);
             break;
           case SECTION_CLASSES:
             bit_chain_init_dat (&sec_dat[type],
@@ -4527,7 +4714,7 @@ dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
       Dwg_R2004_Header *_obj = &dwg->fhdr.r2004_header;
       Bit_Chain file_dat = {
         NULL, sizeof (Dwg_R2004_Header), 0UL, 0, 0, R_INVALID, R_INVALID, NULL,
-        30
+        30, NULL
       };
       Bit_Chain *orig_dat = dat;
       /* "AcFssFcAJMB" encrypted: 6840F8F7922AB5EF18DD0BF1 */
@@ -4622,6 +4809,17 @@ dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
 // clang-format off
 AFL_GCC_POP
 
+/* With DWG_OPTS_ARENA the fixups of the decoded objects are allocated from
+   dwg->arena also. */
+EXPORT int
+dwg_encode (Dwg_Data *restrict dwg, Bit_Chain *restrict dat)
+{
+  Dwg_Arena *old_arena = dwg_arena_use (dwg->arena);
+  int error = encode_dwg (dwg, dat);
+  dwg_arena_use (old_arena);
+  return error;
+}
+
 /* utf-8 string without lowercase letters, space or ! */
 static BITCODE_T
 fixup_invalid_tag (const Bit_Chain *restrict dat, char *restrict tag)
@@ -5199,41 +5397,35 @@ dwg_encode_get_class (Dwg_Data *dwg, Dwg_Object *obj)
   // indxf has a different class order
   if (obj->dxfname) // search class by name, not offset
     {
-      int invalid_klass = 0;
-      for (i = 0; i < dwg->num_classes; i++)
+      i = dwg_class_index (dwg, obj->dxfname);
+      if (i < 0)
         {
-          klass = &dwg->dwg_class[i];
-          if (!klass->dxfname)
-            {
-              invalid_klass++;
-              continue;
-            }
-          if (strEQ (obj->dxfname, klass->dxfname))
-            {
-              obj->type = 500 + i;
-              break;
-            }
-          else
+          // alias DICTIONARYWDFLT => ACDBDICTIONARYWDFLT
+          const char *alias = dxf_encode_alias (obj->dxfname);
+          if (alias && (i = dwg_class_index (dwg, alias)) >= 0)
             {
-              // alias DICTIONARYWDFLT => ACDBDICTIONARYWDFLT
-              const char *alias = dxf_encode_alias (obj->dxfname);
-              if (alias && klass->dxfname && strEQ (alias, klass->dxfname))
-                {
-                  // a static string, which cannot be free'd. important for
-                  // indxf
-                  if (dwg->opts & DWG_OPTS_IN)
-                    obj->dxfname = strdup ((char *)alias);
-                  else
-                    obj->dxfname = (char *)alias;
-                  obj->type = 500 + i;
-                  break;
-                }
-              klass = NULL; // inefficient
-
-              if (invalid_klass > 2 && !(dwg->opts & DWG_OPTS_IN))
-                goto search_by_index;
+              // a static string, which cannot be free'd. important for
+              // indxf
+              if (dwg->opts & DWG_OPTS_IN)
+                obj->dxfname = strdup ((char *)alias);
+              else
+                obj->dxfname = (char *)alias;
             }
         }
+      if (i >= 0)
+        {
+          klass = &dwg->dwg_class[i];
+          obj->type = 500 + i;
+        }
+      else if (!(dwg->opts & DWG_OPTS_IN))
+        {
+          int invalid_klass = 0;
+          for (i = 0; i < dwg->num_classes; i++)
+            if (!dwg->dwg_class[i].dxfname)
+              invalid_klass++;
+          if (invalid_klass > 2)
+            goto search_by_index;
+        }
     }
   else // search by index
     {
@@ -5284,8 +5476,9 @@ dwg_encode_variable_type (Dwg_Data *restrict dwg, Bit_Chain *restrict dat,
               klass->item_class_id = 0x1f2;
               if (!klass->dxfname || strNE (klass->dxfname, obj->dxfname))
                 {
-                  free (klass->dxfname);
+                  dwg_free_mem (klass->dxfname);
                   klass->dxfname = strdup (obj->dxfname);
+                  dwg_free_class_map (dwg);
                 }
               is_entity = 0;
             }
@@ -5304,8 +5497,9 @@ dwg_encode_variable_type (Dwg_Data *restrict dwg, Bit_Chain *restrict dat,
               klass->item_class_id = 0x1f3;
               if (!klass->dxfname || strNE (klass->dxfname, obj->dxfname))
                 {
-                  free (klass->dxfname);
+                  dwg_free_mem (klass->dxfname);
                   klass->dxfname = strdup (obj->dxfname);
+                  dwg_free_class_map (dwg);
                 }
               is_entity = 1;
             }
@@ -5424,6 +5618,24 @@ dwg_encode_add_object (Dwg_Object *restrict obj, Bit_Chain *restrict dat,
   if (dat->byte + obj->size < dat->size)
     bit_chain_alloc_size (dat, obj->size);
 
+  /* Unchanged objects of the same version: copy the decoded bits.
+     Handles are never renumbered, so the handle stream needs no fixups. */
+  if (obj->raw && !obj->dirty
+      && dwg->header.from_version == dwg->header.version)
+    {
+      bit_write_MS (dat, obj->size);
+      SINCE (R_2010b)
+      {
+        bit_write_UMC (dat, obj->handlestream_size);
+      }
+      obj->address = dat->byte;
+      LOG_INFO (", Size: " FORMAT_MS " [MS], Address: %" PRIuSIZE " (raw)\n",
+                obj->size, obj->address)
+      bit_write_TF (dat, obj->raw, obj->size);
+      bit_write_CRC (dat, address, 0xC0C1);
+      return 0;
+    }
+
   // First write an approximate size here.
   // Then calculate size from the fields. Either <0x7fff or more.
   // Patch it afterwards and check old<>new size if enough space allocated.
@@ -6405,32 +6617,34 @@ downgrade_preR13_header_variables (Bit_Chain *dat, Dwg_Data *restrict dwg)
   if (dat->from_version >= R_13b1)
     {
       // downgrade TV to TFv
-      dwg->header_vars.MENU = realloc (dwg->header_vars.MENU, 15);
-      dwg->header_vars.DIMBLK_T = realloc (dwg->header_vars.DIMBLK_T, 33);
+      dwg->header_vars.MENU = dwg_realloc (dwg->header_vars.MENU, 15);
+      dwg->header_vars.DIMBLK_T = dwg_realloc (dwg->header_vars.DIMBLK_T, 33);
       if (dwg->header.numheader_vars > 114)
         {
-          dwg->header_vars.DIMPOST = realloc (dwg->header_vars.DIMPOST, 16);
-          dwg->header_vars.DIMAPOST = realloc (dwg->header_vars.DIMAPOST, 16);
+          dwg->header_vars.DIMPOST
+              = dwg_realloc (dwg->header_vars.DIMPOST, 16);
+          dwg->header_vars.DIMAPOST
+              = dwg_realloc (dwg->header_vars.DIMAPOST, 16);
         }
       if (dwg->header.numheader_vars > 129)
         {
           dwg->header_vars.DIMBLK1_T
-              = realloc (dwg->header_vars.DIMBLK1_T, 33);
+              = dwg_realloc (dwg->header_vars.DIMBLK1_T, 33);
           dwg->header_vars.DIMBLK2_T
-              = realloc (dwg->header_vars.DIMBLK2_T, 33);
+              = dwg_realloc (dwg->header_vars.DIMBLK2_T, 33);
           dwg->header_vars.unknown_string
-              = realloc (dwg->header_vars.unknown_string, 33);
+              = dwg_realloc (dwg->header_vars.unknown_string, 33);
         }
       if (dwg->header.numheader_vars > 160)
         {
           dwg->header_vars.unit1_name
-              = realloc (dwg->header_vars.unit1_name, 33);
+              = dwg_realloc (dwg->header_vars.unit1_name, 33);
           dwg->header_vars.unit2_name
-              = realloc (dwg->header_vars.unit2_name, 33);
+              = dwg_realloc (dwg->header_vars.unit2_name, 33);
           dwg->header_vars.unit3_name
-              = realloc (dwg->header_vars.unit3_name, 33);
+              = dwg_realloc (dwg->header_vars.unit3_name, 33);
           dwg->header_vars.unit4_name
-              = realloc (dwg->header_vars.unit4_name, 33);
+              = dwg_realloc (dwg->header_vars.unit4_name, 33);
         }
     }
 }
@@ -7110,7 +7324,7 @@ in_postprocess_SEQEND (Dwg_Object *restrict obj, BITCODE_BL num_owned,
     {
       BITCODE_H first, last, ref;
       unsigned i = 0;
-      owned = (BITCODE_H *)calloc (1, sizeof (BITCODE_H));
+      owned = (BITCODE_H *)dwg_calloc (1, sizeof (BITCODE_H));
       dwg_dynapi_entity_value (ow, owner->name, firstfield, &first, 0);
       dwg_dynapi_entity_value (ow, owner->name, lastfield, &last, 0);
       ref = first;
@@ -7141,7 +7355,8 @@ in_postprocess_SEQEND (Dwg_Object *restrict obj, BITCODE_BL num_owned,
             if (i > 1)
               {
                 num_owned = i;
-                owned = (BITCODE_H *)realloc (owned, i * sizeof (BITCODE_H));
+                owned = (BITCODE_H *)dwg_realloc (owned,
+                                                  i * sizeof (BITCODE_H));
               }
           }
       dwg_dynapi_entity_set_value (ow, owner->name, "num_owned", &num_owned,
@@ -7368,7 +7583,7 @@ downconvert_TABLESTYLE (Dwg_Object *restrict obj)
   if (!_obj->num_rowstyles)
     {
       _obj->num_rowstyles = 3;
-      _obj->rowstyles = (Dwg_TABLESTYLE_rowstyles *)calloc (
+      _obj->rowstyles = (Dwg_TABLESTYLE_rowstyles *)dwg_calloc (
           3, sizeof (Dwg_TABLESTYLE_rowstyles));
     }
   // 0: data, 1: title, 2: header
@@ -7395,7 +7610,7 @@ downconvert_TABLESTYLE (Dwg_Object *restrict obj)
                                .content_format.value_format_string);
     if (u8 && (destlen = strlen (u8)))
       {
-        char *dest = malloc (destlen + 1);
+        char *dest = dwg_malloc (destlen + 1);
         _obj->rowstyles[0].format_string = (BITCODE_TU)bit_utf8_to_TV (
             dest, (unsigned char *)u8, destlen, destlen - 1, 0,
             dwg->header.codepage);
@@ -7406,7 +7621,7 @@ downconvert_TABLESTYLE (Dwg_Object *restrict obj)
   if (!_obj->rowstyles[0].num_borders)
     {
       _obj->rowstyles[0].num_borders = 6;
-      _obj->rowstyles[0].borders = (Dwg_TABLESTYLE_border *)calloc (
+      _obj->rowstyles[0].borders = (Dwg_TABLESTYLE_border *)dwg_calloc (
           6, sizeof (Dwg_TABLESTYLE_border));
     }
   // borders/grid: top, horizontal inside, bottom, left, vertical inside, right
@@ -7423,7 +7638,7 @@ downconvert_TABLESTYLE (Dwg_Object *restrict obj)
           _obj->rowstyles[0].borders[i].color
               = _obj->sty.cellstyle.borders[i].color;
         }
-      free (_obj->sty.cellstyle.borders);
+      dwg_free_mem (_obj->sty.cellstyle.borders);
       _obj->sty.cellstyle.borders = NULL;
       _obj->sty.cellstyle.num_borders = 0;
     }
@@ -7431,7 +7646,7 @@ downconvert_TABLESTYLE (Dwg_Object *restrict obj)
   if (!_obj->rowstyles[1].num_borders)
     {
       _obj->rowstyles[1].num_borders = 6;
-      _obj->rowstyles[1].borders = (Dwg_TABLESTYLE_border *)calloc (
+      _obj->rowstyles[1].borders = (Dwg_TABLESTYLE_border *)dwg_calloc (
           6, sizeof (Dwg_TABLESTYLE_border));
       _obj->rowstyles[1].text_color.method = 0xc1;
       _obj->rowstyles[1].fill_color.method = 0xc1;
@@ -7471,7 +7686,7 @@ downconvert_TABLESTYLE (Dwg_Object *restrict obj)
   if (!_obj->rowstyles[2].num_borders)
     {
       _obj->rowstyles[2].num_borders = 6;
-      _obj->rowstyles[2].borders = (Dwg_TABLESTYLE_border *)calloc (
+      _obj->rowstyles[2].borders = (Dwg_TABLESTYLE_border *)dwg_calloc (
           6, sizeof (Dwg_TABLESTYLE_border));
       _obj->rowstyles[2].text_color.method = 0xc1;
       _obj->rowstyles[2].fill_color.method = 0xc1;
@@ -7537,13 +7752,13 @@ downconvert_MLEADERSTYLE (Dwg_Object *restrict obj)
     return;
   oo->num_eed += 1;
   if (idx)
-    oo->eed
-        = (Dwg_Eed *)realloc (oo->eed, (oo->num_eed + 1) * sizeof (Dwg_Eed));
+    oo->eed = (Dwg_Eed *)dwg_realloc (oo->eed,
+                                      (oo->num_eed + 1) * sizeof (Dwg_Eed));
   else
-    oo->eed = (Dwg_Eed *)calloc (2, sizeof (Dwg_Eed));
+    oo->eed = (Dwg_Eed *)dwg_calloc (2, sizeof (Dwg_Eed));
   dwg_add_handle (&oo->eed[idx].handle, 5, eedhdl, NULL);
   oo->eed[idx].size = 3;
-  oo->eed[idx].data = (Dwg_Eed_Data *)calloc (3, 1);
+  oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (3, 1);
   oo->eed[idx].data->code = 70;
   _obj = oo->tio.MLEADERSTYLE;
   oo->eed[idx].data->u.eed_70.rs
@@ -7631,15 +7846,15 @@ downconvert_DIMSTYLE (Bit_Chain *restrict dat, Dwg_Object *restrict obj)
                  obj->handle.value);
       oo->num_eed += 5;
       if (idx)
-        oo->eed = (Dwg_Eed *)realloc (oo->eed,
-                                      (oo->num_eed + 1) * sizeof (Dwg_Eed));
+        oo->eed = (Dwg_Eed *)dwg_realloc (
+            oo->eed, (oo->num_eed + 1) * sizeof (Dwg_Eed));
       else
-        oo->eed = (Dwg_Eed *)calloc (6, sizeof (Dwg_Eed));
+        oo->eed = (Dwg_Eed *)dwg_calloc (6, sizeof (Dwg_Eed));
       // AnnotativeData
       dwg_add_handle (&oo->eed[idx].handle, 5, eedhdl1, NULL);
       oo->eed[idx].size = 28;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (20, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (20, 1);
       oo->eed[idx].data->code = 0;
       oo->eed[idx].data->u.eed_0.length = 14; // sizeof ("AnnotativeData") - 1;
       oo->eed[idx].data->u.eed_0.codepage = 30;
@@ -7647,24 +7862,24 @@ downconvert_DIMSTYLE (Bit_Chain *restrict dat, Dwg_Object *restrict obj)
       idx++;
       oo->eed[idx].size = 0;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (2, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (2, 1);
       oo->eed[idx].data->code = 2; // open
       idx++;
       oo->eed[idx].size = 0;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (3, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (3, 1);
       oo->eed[idx].data->code = 70;
       oo->eed[idx].data->u.eed_70.rs = 1;
       idx++;
       oo->eed[idx].size = 0;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (3, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (3, 1);
       oo->eed[idx].data->code = 70;
       oo->eed[idx].data->u.eed_70.rs = 1;
       idx++;
       oo->eed[idx].size = 0;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (2, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (2, 1);
       oo->eed[idx].data->code = 2;
       oo->eed[idx].data->u.eed_2.close = 1;
       idx++;
@@ -7679,22 +7894,22 @@ downconvert_DIMSTYLE (Bit_Chain *restrict dat, Dwg_Object *restrict obj)
                  obj->handle.value);
       oo->num_eed += 2;
       if (idx)
-        oo->eed = (Dwg_Eed *)realloc (oo->eed,
-                                      (oo->num_eed + 1) * sizeof (Dwg_Eed));
+        oo->eed = (Dwg_Eed *)dwg_realloc (
+            oo->eed, (oo->num_eed + 1) * sizeof (Dwg_Eed));
       else
-        oo->eed = (Dwg_Eed *)calloc (3, sizeof (Dwg_Eed));
+        oo->eed = (Dwg_Eed *)dwg_calloc (3, sizeof (Dwg_Eed));
       // DIMJAG
       dwg_add_handle (&oo->eed[idx].handle, 5, eedhdl2, NULL);
       oo->eed[idx].size = 12;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (3, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (3, 1);
       oo->eed[idx].data->code = 70;
       //_obj = oo->tio.DIMSTYLE;
       oo->eed[idx].data->u.eed_70.rs = 388; // FIXME Which value?
       idx++;
       oo->eed[idx].size = 0;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (9, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (9, 1);
       oo->eed[idx].data->code = 40;
       oo->eed[idx].data->u.eed_40.real = 1.5; // FIXME Which value?
       idx++;
@@ -7708,22 +7923,22 @@ downconvert_DIMSTYLE (Bit_Chain *restrict dat, Dwg_Object *restrict obj)
                  obj->handle.value);
       oo->num_eed += 2;
       if (idx)
-        oo->eed = (Dwg_Eed *)realloc (oo->eed,
-                                      (oo->num_eed + 1) * sizeof (Dwg_Eed));
+        oo->eed = (Dwg_Eed *)dwg_realloc (
+            oo->eed, (oo->num_eed + 1) * sizeof (Dwg_Eed));
       else
-        oo->eed = (Dwg_Eed *)calloc (3, sizeof (Dwg_Eed));
+        oo->eed = (Dwg_Eed *)dwg_calloc (3, sizeof (Dwg_Eed));
       // DIMTALN
       dwg_add_handle (&oo->eed[idx].handle, 5, eedhdl2, NULL);
       oo->eed[idx].size = 6;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (3, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (3, 1);
       oo->eed[idx].data->code = 70;
       //_obj = oo->tio.DIMSTYLE;
       oo->eed[idx].data->u.eed_70.rs = 392; // FIXME Which value?
       idx++;
       oo->eed[idx].size = 0;
       oo->eed[idx].raw = NULL;
-      oo->eed[idx].data = (Dwg_Eed_Data *)calloc (3, 1);
+      oo->eed[idx].data = (Dwg_Eed_Data *)dwg_calloc (3, 1);
       oo->eed[idx].data->code = 70;
       oo->eed[idx].data->u.eed_70.rs = 0; // FIXME Which value?
       idx++;
@@ -7738,7 +7953,8 @@ downconvert_DIMSTYLE (Bit_Chain *restrict dat, Dwg_Object *restrict obj)
                 obj->handle.value, idx, oo->num_eed);
       oo->eed[idx].data = NULL;
       oo->num_eed = idx;
-      oo->eed = (Dwg_Eed *)realloc (oo->eed, oo->num_eed * sizeof (Dwg_Eed));
+      oo->eed
+          = (Dwg_Eed *)dwg_realloc (oo->eed, oo->num_eed * sizeof (Dwg_Eed));
     }
 }
 
@@ -7756,11 +7972,11 @@ dwg_convert_LTYPE_strings_area (const Dwg_Data *restrict dwg,
           _obj->has_strings_area = 0;
           return;
         }
-      _obj->strings_area = calloc (1, 512);
+      _obj->strings_area = dwg_calloc (1, 512);
       if (!_obj->strings_area)
         {
           _obj->has_strings_area = 0;
-          free (old);
+          dwg_free_mem (old);
           return;
         }
       _obj->has_strings_area = 1;
@@ -7768,7 +7984,7 @@ dwg_convert_LTYPE_strings_area (const Dwg_Data *restrict dwg,
         {
           _obj->strings_area[i * 2] = old[i];
         }
-      free (old);
+      dwg_free_mem (old);
     }
   else if (dwg->header.from_version > R_2004 && dwg->header.version <= R_2004)
     {
@@ -7776,13 +7992,13 @@ dwg_convert_LTYPE_strings_area (const Dwg_Data *restrict dwg,
       BITCODE_TF old = _obj->strings_area;
       if (!old)
         _obj->has_strings_area = 0;
-      _obj->strings_area = calloc (1, 256);
+      _obj->strings_area = dwg_calloc (1, 256);
       if (!_obj->strings_area || !old)
         { // all empty
           if (old)
-            free (old);
+            dwg_free_mem (old);
           if (_obj->strings_area)
-            free (_obj->strings_area);
+            dwg_free_mem (_obj->strings_area);
           _obj->strings_area = NULL;
           return;
         }
@@ -7791,7 +8007,7 @@ dwg_convert_LTYPE_strings_area (const Dwg_Data *restrict dwg,
         {
           _obj->strings_area[i] = old[i * 2];
         }
-      free (old);
+      dwg_free_mem (old);
     }
 }
 
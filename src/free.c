@@ -58,7 +58,7 @@ static BITCODE_BL rcount1, rcount2;
 #define FREE_IF(ptr)                                                          \
   {                                                                           \
     if (ptr)                                                                  \
-      free (ptr);                                                             \
+      dwg_free_mem (ptr);                                                     \
     ptr = NULL;                                                               \
   }
 
@@ -111,7 +111,7 @@ static BITCODE_BL rcount1, rcount2;
 #define VALUE_HANDLE(ref, nam, _code, dxf)                                    \
   if (ref && !ref->handleref.is_global)                                       \
     {                                                                         \
-      free (ref);                                                             \
+      dwg_free_mem (ref);                                                     \
       ref = NULL;                                                             \
     } /* else freed globally */
 #define FIELD_DATAHANDLE(name, code, dxf) FIELD_HANDLE (name, code, dxf)
@@ -944,23 +944,16 @@ free_preR13_object (Dwg_Object *obj)
   obj->type = DWG_TYPE_FREED;
 }
 
-// using the global dat
-EXPORT void
-dwg_free_object (Dwg_Object *obj)
+// with the current arena set
+static void
+dwg_free_object_arena (Dwg_Object *obj)
 {
   int error = 0;
   long unsigned int j;
-  Dwg_Data *dwg;
+  Dwg_Data *dwg = obj->parent;
   Bit_Chain *dat = &pdat;
 
-  if (obj && obj->parent)
-    {
-      dwg = obj->parent;
-      dat->version = dwg->header.version;
-      dat->from_version = dwg->header.from_version;
-    }
-  else
-    return;
+  FREE_IF (obj->raw);
   if (obj->type == DWG_TYPE_FREED || obj->tio.object == NULL)
     return;
 
@@ -1242,6 +1235,28 @@ dwg_free_object (Dwg_Object *obj)
   obj->type = DWG_TYPE_FREED;
 }
 
+// using the global dat
+EXPORT void
+dwg_free_object (Dwg_Object *obj)
+{
+  Dwg_Data *dwg;
+  Bit_Chain *dat = &pdat;
+  Dwg_Arena *old_arena;
+
+  if (obj && obj->parent)
+    {
+      dwg = obj->parent;
+      dat->version = dwg->header.version;
+      dat->from_version = dwg->header.from_version;
+    }
+  else
+    return;
+  // arena memory is not freed, only given back to dwg->arena
+  old_arena = dwg_arena_use (dwg->arena);
+  dwg_free_object_arena (obj);
+  dwg_arena_use (old_arena);
+}
+
 /* Needed when we cast types.
    By fixedtype, not dxfname.
  */
@@ -1619,12 +1634,21 @@ dwg_free_acds (Dwg_Data *dwg)
   return 0;
 }
 
+// A clean decoded object lives completely in the arena
+static int
+arena_owns_object (const Dwg_Data *dwg, const Dwg_Object *obj)
+{
+  return dwg->arena && !obj->dirty
+         && dwg_arena_owns (dwg->arena, obj->tio.object);
+}
+
 void
 dwg_free (Dwg_Data *dwg)
 {
   BITCODE_BL i;
   if (dwg)
     {
+      Dwg_Arena *old_arena = dwg_arena_use (dwg->arena);
       pdat.version = dwg->header.version;
       pdat.from_version = dwg->header.from_version;
       if (dwg->opts)
@@ -1646,7 +1670,8 @@ dwg_free (Dwg_Data *dwg)
       // copied table fields have duplicate pointers, but are freed only once
       for (i = 0; i < dwg->num_objects; ++i)
         {
-          if (!dwg_obj_is_control (&dwg->object[i]))
+          if (!dwg_obj_is_control (&dwg->object[i])
+              && !arena_owns_object (dwg, &dwg->object[i]))
             dwg_free_object (&dwg->object[i]);
         }
       if (dwg->header.version < R_13b1)
@@ -1676,7 +1701,8 @@ dwg_free (Dwg_Data *dwg)
 
       for (i = 0; i < dwg->num_objects; ++i)
         {
-          if (dwg_obj_is_control (&dwg->object[i]))
+          if (dwg_obj_is_control (&dwg->object[i])
+              && !arena_owns_object (dwg, &dwg->object[i]))
             dwg_free_object (&dwg->object[i]);
         }
       if (dwg->num_classes && dwg->dwg_class)
@@ -1715,6 +1741,14 @@ dwg_free (Dwg_Data *dwg)
       dwg->num_objects = dwg->num_classes = dwg->num_object_refs = 0;
       FREE_IF (dwg->object_ordered_ref);
       dwg->num_object_ordered_refs = 0;
+      dwg_free_class_map (dwg);
+      dwg_arena_use (old_arena);
+      if (dwg->arena)
+        {
+          LOG_HANDLE ("free arena of %u blocks\n", dwg->arena->num_blocks)
+          dwg_arena_delete (dwg->arena);
+          dwg->arena = NULL;
+        }
 #undef FREE_IF
     }
 }
@@ -59,7 +59,7 @@
     }
   VERSIONS (R_13b1, R_2004) { // undocumented as such in the ODA spec
       IF_ENCODE_FROM_EARLIER_OR_DXF {
-        free (FIELD_VALUE (unit1_name));
+        dwg_free_mem (FIELD_VALUE (unit1_name));
         FIELD_VALUE (unit1_name) = strdup ("m");
       }
       FIELD_TV (unit1_name, 0);
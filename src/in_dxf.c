@@ -67,7 +67,16 @@ dwg_find_tablehandle_silent (Dwg_Data *restrict dwg, const char *restrict name,
 /* the current version per spec block */
 static unsigned int cur_ver = 0;
 static char buf[4096];
-static long start, end; // stream offsets
+/* With DWG_OPTS_STREAM dat->chain is only a window into fp, which is
+   refilled before each pair, when the cursor gets near its end. */
+static struct
+{
+  FILE *fp;
+  size_t offset; // file offset of dat->chain[0]
+  int eof;
+} dxf_stream;
+#define DXF_STREAM_WINDOW 0x100000  // 1MB
+#define DXF_STREAM_MINLEFT 0x10000  // 64K, larger than any pair
 static array_hdls *header_hdls = NULL;
 static array_hdls *eed_hdls = NULL;
 static array_hdls *obj_hdls = NULL;
@@ -685,12 +694,72 @@ dxf_free_pair (Dxf_Pair *pair)
   pair = NULL;
 }
 
+// Move the unread rest to the front of the window and read the next chunk.
+static void
+dxf_stream_fill (Bit_Chain *dat)
+{
+  size_t left, size;
+  if (dxf_stream.eof || dat->size - dat->byte >= DXF_STREAM_MINLEFT)
+    return;
+  left = dat->size - dat->byte;
+  if (left)
+    memmove (dat->chain, &dat->chain[dat->byte], left);
+  dxf_stream.offset += dat->byte;
+  dat->byte = 0;
+  size = fread (&dat->chain[left], 1, DXF_STREAM_WINDOW - left,
+                dxf_stream.fp);
+  dat->size = left + size;
+  if (size < DXF_STREAM_WINDOW - left)
+    {
+      dxf_stream.eof = 1;
+      // properly end the buffer for strtol()/... readers
+      if (dat->size && dat->chain[dat->size - 1] != '\n'
+          && !(dat->opts & DWG_OPTS_DXFB))
+        dat->chain[dat->size++] = '\n';
+    }
+  dat->chain[dat->size] = '\0';
+}
+
+static int
+dxf_stream_open (Bit_Chain *dat)
+{
+  memset (&dxf_stream, 0, sizeof (dxf_stream));
+  dat->chain = (unsigned char *)malloc (DXF_STREAM_WINDOW + 2);
+  if (!dat->chain)
+    {
+      LOG_ERROR ("Out of memory");
+      return DWG_ERR_OUTOFMEM;
+    }
+  dxf_stream.fp = dat->fh;
+  dat->byte = 0;
+  dat->size = 0;
+  dxf_stream_fill (dat);
+  LOG_TRACE ("Streaming DXF with a %u byte window\n",
+             (unsigned)DXF_STREAM_WINDOW);
+  return 0;
+}
+
+static void
+dxf_stream_close (Bit_Chain *dat)
+{
+  if (!dxf_stream.fp)
+    return;
+  free (dat->chain);
+  dat->chain = NULL;
+  dat->byte = 0;
+  dat->size = 0;
+  memset (&dxf_stream, 0, sizeof (dxf_stream));
+}
+
 static Dxf_Pair *
 ATTRIBUTE_MALLOC
 dxf_read_pair (Bit_Chain *dat)
 {
-  Dxf_Pair *pair = (Dxf_Pair *)xcalloc (1, sizeof (Dxf_Pair));
+  Dxf_Pair *pair;
   const int is_binary = dat->opts & DWG_OPTS_DXFB;
+  if (dxf_stream.fp)
+    dxf_stream_fill (dat);
+  pair = (Dxf_Pair *)xcalloc (1, sizeof (Dxf_Pair));
   if (!pair)
     return NULL;
   if (dat->size - dat->byte < 6) // at least 0\nEOF\n
@@ -13051,7 +13120,10 @@ dwg_read_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
   if (!dat->chain && dat->fh)
     {
-      error = dat_read_stream (dat, dat->fh);
+      if (dwg->opts & DWG_OPTS_STREAM)
+        error = dxf_stream_open (dat);
+      else
+        error = dat_read_stream (dat, dat->fh);
       if (error >= DWG_ERR_CRITICAL)
         return error;
       if (dat->size >= 22
@@ -13065,6 +13137,7 @@ dwg_read_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   if (dat->size < 256)
     {
       LOG_ERROR ("DXF input too small, %" PRIuSIZE " byte.\n", dat->size);
+      dxf_stream_close (dat);
       return DWG_ERR_IOERROR;
     }
   /* Fail early on DWG */
@@ -13072,6 +13145,7 @@ dwg_read_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
       || !memcmp (dat->chain, "AC2.10", 4) || !memcmp (dat->chain, "MC0.0", 4))
     {
       LOG_ERROR ("This is a DWG, not a DXF\n");
+      dxf_stream_close (dat);
       return DWG_ERR_INVALIDDWG;
     }
   dat->opts |= DWG_OPTS_INDXF;
@@ -13151,7 +13225,10 @@ dwg_read_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
                 dxf_fixup_header (dat, dwg);
               error = dxf_classes_read (dat, dwg);
               if (error > DWG_ERR_CRITICAL)
-                return error;
+                {
+                  dxf_stream_close (dat);
+                  return error;
+                }
             }
           else if (strEQc (pair->value.s, "TABLES"))
             {
@@ -13259,6 +13336,7 @@ dwg_read_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   else if (dat->byte >= dat->size || (pair == NULL))
     error |= DWG_ERR_IOERROR;
   dxf_free_pair (pair);
+  dxf_stream_close (dat);
   resolve_postponed_header_refs (dwg);
   resolve_postponed_object_refs (dwg);
   LOG_HANDLE ("Resolving pointers from ObjectRef vector:\n");
@@ -13276,6 +13354,7 @@ dwg_read_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
 error:
   dwg->dirty_refs = 0;
+  dxf_stream_close (dat);
   free_array_hdls (header_hdls);
   free_array_hdls (eed_hdls);
   free_array_hdls (obj_hdls);
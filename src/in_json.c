@@ -44,8 +44,8 @@ static unsigned int loglevel;
 
 // not exported
 #define JSMN_STATIC
-// probably not needed in the final version (counting keys)
-#undef JSMN_PARENT_LINKS
+// closing a container is then O(1), not a scan back over all its tokens
+#define JSMN_PARENT_LINKS
 // our files are bigger than 8000
 // In strict mode primitive must be followed by "," or "}" or "]";
 // comma/object/array
@@ -59,6 +59,8 @@ typedef struct jsmntokens
   unsigned int index;
   jsmntok_t *tokens;
   long num_tokens;
+  long num_alloced; // reused for each section and each OBJECTS element
+  size_t pos;       // untokenized OBJECTS array offset
 } jsmntokens_t;
 
 // synced with enum jsmntype_t
@@ -286,6 +288,139 @@ static Bit_Chain *g_dat;
   JSON_TOKENS_CHECK_OVERFLOW (return NULL)
 #define JSON_TOKENS_CHECK_OVERFLOW_VOID JSON_TOKENS_CHECK_OVERFLOW (return)
 
+static size_t
+json_skip_ws (const Bit_Chain *restrict dat, size_t pos)
+{
+  while (pos < dat->size
+         && (dat->chain[pos] == ' ' || dat->chain[pos] == '\t'
+             || dat->chain[pos] == '\r' || dat->chain[pos] == '\n'))
+    pos++;
+  return pos;
+}
+
+// Returns the offset after the JSON value at pos, without tokenizing it.
+static size_t
+json_skip_value (const Bit_Chain *restrict dat, size_t pos)
+{
+  int depth = 0;
+  const unsigned char *s = dat->chain;
+  for (; pos < dat->size; pos++)
+    {
+      switch (s[pos])
+        {
+        case '"':
+          for (pos++; pos < dat->size && s[pos] != '"'; pos++)
+            if (s[pos] == '\\')
+              pos++;
+          if (!depth)
+            return pos < dat->size ? pos + 1 : pos;
+          break;
+        case '{':
+        case '[':
+          depth++;
+          break;
+        case '}':
+        case ']':
+          if (depth <= 1)
+            return depth ? pos + 1 : pos;
+          depth--;
+          break;
+        case ',':
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+          if (!depth)
+            return pos;
+          break;
+        default:
+          break;
+        }
+    }
+  return pos;
+}
+
+// Split the JSON array at pos into its top-level elements, without
+// tokenizing it. Returns the number of elements, with their start and end
+// offsets in *spanp (2 per element), and the offset after the array in *endp.
+static int
+json_array_spans (const Bit_Chain *restrict dat, size_t pos,
+                  size_t **restrict spanp, size_t *restrict endp)
+{
+  int size = 0, alloced = 0;
+  size_t *spans = NULL;
+  pos = json_skip_ws (dat, pos + 1);
+  while (pos < dat->size && dat->chain[pos] != ']')
+    {
+      size_t end = json_skip_value (dat, pos);
+      if (end == pos)
+        break;
+      if (size == alloced)
+        {
+          size_t *old = spans;
+          alloced = alloced ? 2 * alloced : 1024;
+          spans = (size_t *)realloc (spans, 2 * alloced * sizeof (size_t));
+          if (!spans)
+            {
+              free (old);
+              *spanp = NULL;
+              return -1;
+            }
+        }
+      spans[2 * size] = pos;
+      spans[2 * size + 1] = end;
+      size++;
+      pos = json_skip_ws (dat, end);
+      if (pos < dat->size && dat->chain[pos] == ',')
+        pos = json_skip_ws (dat, pos + 1);
+    }
+  *spanp = spans;
+  *endp = pos < dat->size ? pos + 1 : pos;
+  return size;
+}
+
+// Tokenize only the JSON value from start to end into the reused tokens
+// buffer, growing it as needed. jsmn continues after JSMN_ERROR_NOMEM.
+static int
+json_tokenize (Bit_Chain *restrict dat, jsmntokens_t *restrict tokens,
+               size_t start, size_t end)
+{
+  jsmn_parser parser;
+  int num;
+  jsmn_init (&parser);
+  parser.pos = (unsigned int)start;
+  while ((num = jsmn_parse (&parser, (char *)dat->chain, end, tokens->tokens,
+                            (unsigned int)tokens->num_alloced - 1))
+         == JSMN_ERROR_NOMEM)
+    {
+      jsmntok_t *old = tokens->tokens;
+      tokens->num_alloced *= 2;
+      tokens->tokens = (jsmntok_t *)realloc (
+          tokens->tokens, tokens->num_alloced * sizeof (jsmntok_t));
+      if (!tokens->tokens)
+        {
+          LOG_ERROR ("Out of memory");
+          tokens->tokens = old;
+          tokens->num_alloced /= 2;
+          return DWG_ERR_OUTOFMEM;
+        }
+    }
+  if (num <= 0)
+    {
+      const long remaining = (long)(end - parser.pos);
+      LOG_ERROR ("Invalid json. jsmn error %d at pos: %u (%.*s ...)", num,
+                 parser.pos, (int)MIN (remaining, 20),
+                 &dat->chain[parser.pos]);
+      tokens->num_tokens = 0;
+      return DWG_ERR_INVALIDDWG;
+    }
+  // the overflow checks may peek one past the end
+  memset (&tokens->tokens[num], 0, sizeof (jsmntok_t));
+  tokens->num_tokens = num;
+  tokens->index = 0;
+  return 0;
+}
+
 // advance until next known first-level type
 // on OBJECT to end of OBJECT
 // on ARRAY to end of ARRAY
@@ -2109,6 +2244,158 @@ json_set_sizefield (void *restrict _obj,
 }
 #undef FIXUP_SIZE
 
+/* Hashed key lookup into the dynapi field tables.
+   The object, subclass and common field tables are unsorted, and every key
+   of every object was searched linearly. Each table gets an open-addressing
+   name index on first use, found by the table pointer, so a key lookup is
+   one hash probe. The first field of a duplicate name wins, as before.
+   All indices are freed in json_free_globals. */
+typedef struct _json_field_index
+{
+  const Dwg_DYNAPI_field *fields;
+  unsigned short *slots; // field index + 1, 0 is empty
+  unsigned int mask;
+} json_field_index_t;
+
+static json_field_index_t *field_indices; // by fields pointer
+static unsigned int field_indices_mask;   // size - 1, or 0 if unallocated
+static unsigned int num_field_indices;
+
+static inline unsigned int
+json_key_hash (const char *key)
+{
+  // FNV-1a
+  unsigned int h = 2166136261U;
+  for (; *key; key++)
+    h = (h ^ (unsigned char)*key) * 16777619U;
+  return h;
+}
+
+static inline unsigned int
+json_fields_hash (const Dwg_DYNAPI_field *fields)
+{
+  return (unsigned int)(((uintptr_t)fields >> 4) * 2654435761U);
+}
+
+static int
+json_field_index_build (json_field_index_t *idx,
+                        const Dwg_DYNAPI_field *fields)
+{
+  unsigned int num = 0, size = 8;
+  for (const Dwg_DYNAPI_field *f = fields; f->name; f++)
+    num++;
+  if (num >= 0xffff)
+    return 1;
+  while (size < 2 * num)
+    size <<= 1;
+  idx->slots = (unsigned short *)calloc (size, sizeof (unsigned short));
+  if (!idx->slots)
+    return 1;
+  idx->fields = fields;
+  idx->mask = size - 1;
+  for (unsigned int i = 0; i < num; i++)
+    {
+      unsigned int h = json_key_hash (fields[i].name) & idx->mask;
+      while (idx->slots[h] && strNE (fields[idx->slots[h] - 1].name,
+                                     fields[i].name))
+        h = (h + 1) & idx->mask;
+      if (!idx->slots[h])
+        idx->slots[h] = (unsigned short)(i + 1);
+    }
+  return 0;
+}
+
+// rehash all indices into a new table of twice the size
+static int
+json_field_indices_grow (void)
+{
+  unsigned int size = field_indices_mask ? 2 * (field_indices_mask + 1) : 64;
+  json_field_index_t *indices
+      = (json_field_index_t *)calloc (size, sizeof (json_field_index_t));
+  if (!indices)
+    return 1;
+  for (unsigned int i = 0; field_indices_mask && i <= field_indices_mask;
+       i++)
+    {
+      unsigned int h;
+      if (!field_indices[i].fields)
+        continue;
+      h = json_fields_hash (field_indices[i].fields) & (size - 1);
+      while (indices[h].fields)
+        h = (h + 1) & (size - 1);
+      indices[h] = field_indices[i];
+    }
+  free (field_indices);
+  field_indices = indices;
+  field_indices_mask = size - 1;
+  return 0;
+}
+
+static const json_field_index_t *
+json_field_index (const Dwg_DYNAPI_field *restrict fields)
+{
+  unsigned int h;
+  if (!fields)
+    return NULL;
+  if (field_indices_mask)
+    {
+      h = json_fields_hash (fields) & field_indices_mask;
+      while (field_indices[h].fields)
+        {
+          if (field_indices[h].fields == fields)
+            return &field_indices[h];
+          h = (h + 1) & field_indices_mask;
+        }
+    }
+  if (2 * (num_field_indices + 1) > field_indices_mask
+      && json_field_indices_grow ())
+    return NULL;
+  h = json_fields_hash (fields) & field_indices_mask;
+  while (field_indices[h].fields)
+    h = (h + 1) & field_indices_mask;
+  if (json_field_index_build (&field_indices[h], fields))
+    return NULL;
+  num_field_indices++;
+  return &field_indices[h];
+}
+
+static void
+json_field_indices_free (void)
+{
+  for (unsigned int i = 0; field_indices_mask && i <= field_indices_mask;
+       i++)
+    free (field_indices[i].slots);
+  free (field_indices);
+  field_indices = NULL;
+  field_indices_mask = 0;
+  num_field_indices = 0;
+}
+
+static const Dwg_DYNAPI_field *
+json_find_field (const Dwg_DYNAPI_field *restrict fields,
+                 const char *restrict key)
+{
+  const json_field_index_t *idx = json_field_index (fields);
+  unsigned int h;
+  if (!idx)
+    { // out of memory: linear search
+      const Dwg_DYNAPI_field *f = fields;
+      for (; f && f->name; f++)
+        if (strEQ (f->name, key))
+          return f;
+      return NULL;
+    }
+  h = json_key_hash (key) & idx->mask;
+  while (idx->slots[h])
+    {
+      const Dwg_DYNAPI_field *f = &fields[idx->slots[h] - 1];
+      if (strEQ (f->name, key))
+        return f;
+      h = (h + 1) & idx->mask;
+    }
+  return NULL;
+}
+
 // needs to be recursive, for search in subclasses
 static int
 _set_struct_field (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
@@ -2117,17 +2404,13 @@ _set_struct_field (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
                    const Dwg_DYNAPI_field *restrict fields)
 {
   Dwg_Data *restrict dwg = obj->parent;
-  const Dwg_DYNAPI_field *f = (Dwg_DYNAPI_field *)fields;
+  const Dwg_DYNAPI_field *f;
   const jsmntok_t *t = &tokens->tokens[tokens->index];
   int error = 0;
   LOG_INSANE ("-search %s key %s: %s %.*s\n", name, key, t_typename[t->type],
               t->end - t->start, &dat->chain[t->start]);
   JSON_TOKENS_CHECK_OVERFLOW_ERR;
-  for (; f->name; f++)
-    {
-      if (strEQ (f->name, key))
-        break;
-    }
+  f = json_find_field (fields, key);
   // Found common, subclass or entity key, check types
   if (f && f->name)
     {
@@ -2736,7 +3019,7 @@ _set_struct_field (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
                   JSON_TOKENS_CHECK_OVERFLOW_ERR
                   json_fixed_key (key1, dat, tokens);
                   LOG_INSANE ("-search %s key: %s\n", subclass, key1);
-                  f1 = dwg_dynapi_subclass_field (subclass, key1);
+                  f1 = json_find_field (sfields, key1);
                   if (f1)
                     {
                       LOG_INSANE ("-found %s [%s]\n", f1->name, f1->type);
@@ -2749,7 +3032,7 @@ _set_struct_field (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
                     {
                       *rest = '\0';
                       rest++;
-                      f1 = dwg_dynapi_subclass_field (subclass, key1);
+                      f1 = json_find_field (sfields, key1);
                       if (f1 && *rest)
                         {
                           char *sb1 = dwg_dynapi_subclass_name (f1->type);
@@ -2810,7 +3093,7 @@ _set_struct_field (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
               JSON_TOKENS_CHECK_OVERFLOW_ERR
               json_fixed_key (key1, dat, tokens);
               LOG_INSANE ("-search %s key %s\n", subclass, key1);
-              f1 = dwg_dynapi_subclass_field (subclass, key1);
+              f1 = json_find_field (sfields, key1);
               if (f1)
                 {
                   // subclass offset for _obj
@@ -2823,7 +3106,7 @@ _set_struct_field (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
                 {
                   *rest = '\0';
                   rest++;
-                  f1 = dwg_dynapi_subclass_field (subclass, key1);
+                  f1 = json_find_field (sfields, key1);
                   if (f1 && *rest)
                     {
                       void *off = &((char *)_obj)[f->offset + f1->offset];
@@ -2989,21 +3272,26 @@ json_OBJECTS (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
               jsmntokens_t *restrict tokens)
 {
   const char *section = "OBJECTS";
-  const jsmntok_t *t = &tokens->tokens[tokens->index];
-  int i, size;
-  if (t->type != JSMN_ARRAY || dwg->num_objects)
+  const jsmntok_t *t;
+  // The array is not tokenized as a whole, only each element in turn.
+  size_t pos = tokens->pos;
+  size_t *spans; // element start and end offsets
+  int i, e, size, num_elems;
+  if (pos >= dat->size || dat->chain[pos] != '[' || dwg->num_objects)
     {
-      LOG_ERROR ("Unexpected %s at %u of %ld tokens, expected %s ARRAY",
-                 t_typename[t->type], tokens->index, tokens->num_tokens,
-                 section);
-      json_advance_unknown (dat, tokens, t->type, 0);
+      LOG_ERROR ("Unexpected %.*s at %" PRIuSIZE ", expected %s ARRAY",
+                 pos < dat->size ? 1 : 0, &dat->chain[pos], pos, section);
       return DWG_ERR_INVALIDTYPE;
     }
-  size = t->size;
-  LOG_TRACE ("\n%s pos:%d [%d members]\n--------------------\n", section,
-             tokens->index, size);
-  tokens->index++;
-  JSON_TOKENS_CHECK_OVERFLOW_ERR
+  size = json_array_spans (dat, pos, &spans, &tokens->pos);
+  if (size < 0)
+    {
+      LOG_ERROR ("Out of memory");
+      return DWG_ERR_OUTOFMEM;
+    }
+  num_elems = size;
+  LOG_TRACE ("\n%s pos:%" PRIuSIZE " [%d members]\n--------------------\n",
+             section, pos, size);
   if (dwg->num_objects == 0)
     {
       // faster version of dwg_add_object()
@@ -3018,6 +3306,7 @@ json_OBJECTS (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
   if (!dwg->object)
     {
       LOG_ERROR ("Out of memory");
+      free (spans);
       return DWG_ERR_OUTOFMEM;
     }
   if (dwg->header.from_version < R_13b1)
@@ -3026,7 +3315,8 @@ json_OBJECTS (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
           = (Dwg_Section *)calloc (SECTION_VX + 1, sizeof (Dwg_Section));
     }
   dwg->num_objects += size;
-  for (i = 0; i < size; i++)
+  // skipped elements reuse the slot i, e is the element
+  for (i = e = 0; i < size; i++, e++)
     {
       char name[80];
       int keys;
@@ -3088,6 +3378,23 @@ json_OBJECTS (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
         }
 
       memset (obj, 0, sizeof (Dwg_Object));
+      if (e >= num_elems)
+        {
+          // skipped objects
+          dwg->num_objects = i;
+          break;
+        }
+      // tokenize the next element only
+      {
+        int error
+            = json_tokenize (dat, tokens, spans[2 * e], spans[2 * e + 1]);
+        if (error)
+          {
+            dwg->num_objects = i;
+            free (spans);
+            return error;
+          }
+      }
       t = &tokens->tokens[tokens->index];
       if (t->type != JSMN_OBJECT)
         {
@@ -3430,6 +3737,7 @@ json_OBJECTS (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
               if (!obj->type) // TODO: We could eventually relax this
                 {
                   LOG_ERROR ("Required %s.type missing", name)
+                  free (spans);
                   return DWG_ERR_INVALIDDWG;
                 }
             }
@@ -3611,16 +3919,19 @@ json_OBJECTS (Bit_Chain *restrict dat, Dwg_Data *restrict dwg,
     }
   LOG_TRACE ("End of %s\n", section)
   tokens->index--;
+  free (spans);
   return 0;
 harderr:
   dwg->num_objects = i;
   LOG_TRACE ("End of %s (hard error)\n", section)
   tokens->index--;
+  free (spans);
   return DWG_ERR_INVALIDDWG;
 typeerr:
   dwg->num_objects = i;
   LOG_TRACE ("End of %s (type error)\n", section)
   tokens->index--;
+  free (spans);
   return DWG_ERR_INVALIDTYPE;
 }
 
@@ -5009,15 +5320,15 @@ json_free_globals (jsmntokens_t *tokens)
   if (tokens)
     free (tokens->tokens);
   free (created_by);
+  json_field_indices_free ();
 }
 
 EXPORT int
 dwg_read_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 {
   Dwg_Header *obj = &dwg->header;
-  jsmn_parser parser;
   jsmntokens_t tokens;
-  unsigned int i;
+  size_t pos;
   int error = -1;
   created_by = NULL;
 
@@ -5033,36 +5344,17 @@ dwg_read_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     }
   g_dat = dat;
 
-  jsmn_init (&parser);
-  // How big will it be? This is the max. memory variant.
-  // we could also use less, see jsmn/examples/jsondump.c for small devices.
-  tokens.num_tokens
-      = jsmn_parse (&parser, (char *)dat->chain, dat->size, NULL, 0);
-  if (tokens.num_tokens <= 0)
-    {
-      const long remaining = (long)(dat->size - parser.pos);
-      if (parser.pos > 10 && remaining > 10)
-        {
-          char err[21];
-          memcpy (&err, &dat->chain[parser.pos - 10], 20);
-          err[20] = 0;
-          LOG_ERROR ("Invalid json. jsmn error at pos: %u (... %s ...)",
-                     parser.pos, err);
-        }
-      else
-        {
-          LOG_ERROR ("Invalid json. jsmn error at pos: %u (%.*s ...)",
-                     parser.pos, (int)remaining, &dat->chain[parser.pos]);
-        }
-      return DWG_ERR_INVALIDDWG;
-    }
-  LOG_TRACE ("  num_tokens: %ld\n", tokens.num_tokens);
-  tokens.tokens
-      = (jsmntok_t *)calloc (tokens.num_tokens + 1024, sizeof (jsmntok_t));
+  // Single pass: Each first level section, and each OBJECTS element, is
+  // tokenized on its own into the same growing tokens buffer.
+  // So the tokens memory depends on the largest section or object, not on
+  // the file size.
+  memset (&tokens, 0, sizeof (tokens));
+  tokens.num_alloced = 1024;
+  tokens.tokens = (jsmntok_t *)calloc (tokens.num_alloced, sizeof (jsmntok_t));
   if (!tokens.tokens)
     return DWG_ERR_OUTOFMEM;
 
-  dwg->object_map = hash_new (tokens.num_tokens / 50);
+  dwg->object_map = hash_new (dat->size / 1000);
   if (!dwg->object_map) // we are obviously on a tiny system
     {
       dwg->object_map = hash_new (1024);
@@ -5081,38 +5373,14 @@ dwg_read_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   */
   dat->version = R_2000;
 
-  jsmn_init (&parser); // reset pos to 0
-  error = jsmn_parse (&parser, (char *)dat->chain, dat->size, tokens.tokens,
-                      (unsigned int)tokens.num_tokens);
-  if (error < 0)
-    {
-      const long remaining = (long)(dat->size - parser.pos);
-      if (parser.pos > 10 && remaining > 10)
-        {
-          char err[21];
-          memcpy (&err, &dat->chain[parser.pos - 10], 20);
-          err[20] = 0;
-          LOG_ERROR ("Invalid json. jsmn error %d at the %u-th token, pos: %u "
-                     "(... %s ...)",
-                     error, parser.toknext, parser.pos, err);
-        }
-      else
-        {
-          LOG_ERROR ("Invalid json. jsmn error %d at the %u-th token, pos: %u "
-                     "(%.*s ...)",
-                     error, parser.toknext, parser.pos, (int)remaining,
-                     &dat->chain[parser.pos]);
-        }
-      json_free_globals (&tokens);
-      return DWG_ERR_INVALIDDWG;
-    }
-
-  if (tokens.tokens[0].type != JSMN_OBJECT)
+  pos = json_skip_ws (dat, 0);
+  if (pos >= dat->size || dat->chain[pos] != '{')
     {
       fprintf (stderr, "First JSON element is not an object/hash\n");
       json_free_globals (&tokens);
       return DWG_ERR_INVALIDDWG;
     }
+  pos++;
 
   // valid first level tokens:
   // created_by: string
@@ -5123,39 +5391,63 @@ dwg_read_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   //                  AuxHeader, SecondHeader
   // section arrays: CLASSES, OBJECTS, HANDLES
   error = 0;
-  for (tokens.index = 1; tokens.index < (unsigned int)tokens.num_tokens;
-       tokens.index++)
+  while (1)
     {
       char key[80];
-      const jsmntok_t *t = &tokens.tokens[tokens.index];
-      const int len = t->end - t->start;
+      size_t end;
+      int len;
 
-      if (t->type == JSMN_UNDEFINED)
+      pos = json_skip_ws (dat, pos);
+      if (pos < dat->size && dat->chain[pos] == ',')
+        pos = json_skip_ws (dat, pos + 1);
+      if (pos >= dat->size || dat->chain[pos] == '}')
         break;
-      if (t->type != JSMN_STRING)
+      if (dat->chain[pos] != '"')
         {
-          LOG_ERROR ("Unexpected JSON key at %u of %ld tokens, got %s",
-                     tokens.index, tokens.num_tokens, t_typename[t->type]);
+          LOG_ERROR ("Unexpected JSON key at pos %" PRIuSIZE ", got %c", pos,
+                     dat->chain[pos]);
           json_free_globals (&tokens);
           return DWG_ERR_INVALIDDWG;
         }
-      if (len >= 80)
+      end = json_skip_value (dat, pos);
+      len = (int)(end - pos) - 2;
+      if (len < 0 || len >= 80)
         {
-          LOG_ERROR ("Unknown JSON key at %u of %ld tokens, len %d > 80",
-                     tokens.index, tokens.num_tokens, len);
+          LOG_ERROR ("Unknown JSON key at pos %" PRIuSIZE ", len %d > 80",
+                     pos, len);
           json_free_globals (&tokens);
           return DWG_ERR_INVALIDDWG;
         }
-      memcpy (key, &dat->chain[t->start], len);
+      memcpy (key, &dat->chain[pos + 1], len);
       key[len] = '\0';
-      tokens.index++;
-      if (tokens.index > (unsigned int)tokens.num_tokens)
+      pos = json_skip_ws (dat, end);
+      if (pos < dat->size && dat->chain[pos] == ':')
+        pos = json_skip_ws (dat, pos + 1);
+      if (pos < dat->size && dat->chain[pos] == '[' && !dwg->num_objects
+          && strEQc (key, "OBJECTS"))
+        end = pos + 1; // json_OBJECTS splits the array and skips it
+      else
+        end = json_skip_value (dat, pos);
+      if (pos >= dat->size || end == pos)
         {
-          LOG_ERROR ("Unexpected end of JSON at %u of %ld tokens %s:%d",
-                     tokens.index, tokens.num_tokens, __FILE__, __LINE__);
+          LOG_ERROR ("Unexpected end of JSON at pos %" PRIuSIZE " %s:%d", pos,
+                     __FILE__, __LINE__);
           json_free_globals (&tokens);
           return DWG_ERR_INVALIDDWG;
         }
+      if (strEQc (key, "OBJECTS"))
+        {
+          tokens.pos = pos;
+          tokens.num_tokens = 0;
+          tokens.index = 0;
+        }
+      else if ((error |= json_tokenize (dat, &tokens, pos, end))
+               >= DWG_ERR_CRITICAL)
+        {
+          json_free_globals (&tokens);
+          return error;
+        }
+      pos = end;
       if (strEQc (key, "created_by"))
         error |= json_created_by (dat, dwg, &tokens);
       else if (strEQc (key, "FILEHEADER"))
@@ -5165,7 +5457,10 @@ dwg_read_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
       else if (strEQc (key, "CLASSES"))
         error |= json_CLASSES (dat, dwg, &tokens);
       else if (strEQc (key, "OBJECTS"))
-        error |= json_OBJECTS (dat, dwg, &tokens);
+        {
+          error |= json_OBJECTS (dat, dwg, &tokens);
+          pos = MAX (pos, tokens.pos);
+        }
       else if (strEQc (key, "THUMBNAILIMAGE"))
         error |= json_THUMBNAILIMAGE (dat, dwg, &tokens);
       else if (strEQc (key, "AuxHeader"))
@@ -5201,8 +5496,8 @@ dwg_read_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
         error |= json_HANDLES (dat, dwg, &tokens);
       else
         {
-          LOG_ERROR ("Unexpected JSON key %s at %u of %ld tokens. %s:%d", key,
-                     tokens.index, tokens.num_tokens, __FUNCTION__, __LINE__);
+          LOG_ERROR ("Unexpected JSON key %s at pos %" PRIuSIZE ". %s:%d",
+                     key, pos, __FUNCTION__, __LINE__);
           LOG_TRACE ("\n")
           json_free_globals (&tokens);
           return error | DWG_ERR_INVALIDTYPE;
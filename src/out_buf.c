@@ -0,0 +1,887 @@
+/*****************************************************************************/
+/*  LibreDWG - free implementation of the DWG file format                    */
+/*                                                                           */
+/*  Copyright (C) 2026 Free Software Foundation, Inc.                        */
+/*                                                                           */
+/*  This library is free software, licensed under the terms of the GNU       */
+/*  General Public License as published by the Free Software Foundation,     */
+/*  either version 3 of the License, or (at your option) any later version.  */
+/*  You should have received a copy of the GNU General Public License        */
+/*  along with this program.  If not, see <http://www.gnu.org/licenses/>.    */
+/*****************************************************************************/
+
+/*
+ * out_buf.c: buffered text output for the DXF, JSON and GeoJSON writers.
+ *            fprintf parses the format and locks the FILE for every group
+ *            code and value, which dominated the export time.
+ *            The double formatter is Grisu2 by Florian Loitsch,
+ *            "Printing Floating-Point Numbers Quickly and Accurately with
+ *            Integers" (PLDI 2010). Its output always reads back to the
+ *            same double, and is the shortest such string in >99.9%.
+ *            With DWG_OPTS_THREADS out_render() lets worker threads render
+ *            runs of objects into memory, written in the original order.
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <math.h>
+#include "out_buf.h"
+#include "decode.h"
+#ifdef OUT_THREADS
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+void
+out_buf_begin (Bit_Chain *restrict dat, Out_Buf *restrict ob)
+{
+  ob->pos = 0;
+  ob->buf = (char *)malloc (OUT_BUF_SIZE);
+  ob->size = ob->buf ? OUT_BUF_SIZE : 0;
+  // on ENOMEM keep writing unbuffered
+  dat->outbuf = ob->buf ? ob : NULL;
+}
+
+void
+out_buf_end (Bit_Chain *restrict dat, Out_Buf *restrict ob)
+{
+  if (dat->outbuf == ob)
+    out_flush (dat);
+  free (ob->buf);
+  ob->buf = NULL;
+  ob->size = 0;
+  dat->outbuf = NULL;
+}
+
+void
+out_flush (Bit_Chain *dat)
+{
+  Out_Buf *ob = dat->outbuf;
+  if (ob && ob->pos && dat->fh)
+    {
+      fwrite (ob->buf, 1, ob->pos, dat->fh);
+      ob->pos = 0;
+    }
+}
+
+// Without dat->fh the buffer is the target, and grows. 0 on ENOMEM
+static int
+out_grow (Out_Buf *ob, size_t len)
+{
+  size_t size = ob->size;
+  char *buf;
+  while (len > size - ob->pos)
+    size *= 2;
+  buf = (char *)realloc (ob->buf, size);
+  if (!buf)
+    return 0;
+  ob->buf = buf;
+  ob->size = size;
+  return 1;
+}
+
+void
+out_write (Bit_Chain *restrict dat, const char *restrict s, size_t len)
+{
+  Out_Buf *ob = dat->outbuf;
+  if (!ob)
+    {
+      fwrite (s, 1, len, dat->fh);
+      return;
+    }
+  if (len > ob->size - ob->pos)
+    {
+      if (!dat->fh)
+        {
+          if (!out_grow (ob, len))
+            return;
+          memcpy (&ob->buf[ob->pos], s, len);
+          ob->pos += len;
+          return;
+        }
+      out_flush (dat);
+      if (len > ob->size)
+        {
+          fwrite (s, 1, len, dat->fh);
+          return;
+        }
+    }
+  memcpy (&ob->buf[ob->pos], s, len);
+  ob->pos += len;
+}
+
+void
+out_printf (Bit_Chain *restrict dat, const char *restrict fmt, ...)
+{
+  Out_Buf *ob = dat->outbuf;
+  va_list ap;
+  int n;
+
+  va_start (ap, fmt);
+  if (!ob)
+    {
+      vfprintf (dat->fh, fmt, ap);
+      va_end (ap);
+      return;
+    }
+  n = vsnprintf (&ob->buf[ob->pos], ob->size - ob->pos, fmt, ap);
+  va_end (ap);
+  if (n < 0)
+    return;
+  if ((size_t)n < ob->size - ob->pos)
+    {
+      ob->pos += n;
+      return;
+    }
+  // truncated: flush or grow, and format again
+  if (!dat->fh)
+    {
+      if (!out_grow (ob, (size_t)n + 1))
+        return;
+      va_start (ap, fmt);
+      ob->pos += vsnprintf (&ob->buf[ob->pos], ob->size - ob->pos, fmt, ap);
+      va_end (ap);
+      return;
+    }
+  out_flush (dat);
+  va_start (ap, fmt);
+  if ((size_t)n < ob->size)
+    ob->pos = vsnprintf (ob->buf, ob->size, fmt, ap);
+  else
+    vfprintf (dat->fh, fmt, ap);
+  va_end (ap);
+}
+
+static void
+out_pad (Bit_Chain *dat, const char *restrict s, int len, int width)
+{
+  static const char spaces[] = "                    ";
+  if (width > len)
+    {
+      int pad = width - len;
+      while (pad > (int)sizeof (spaces) - 1)
+        {
+          out_write (dat, spaces, sizeof (spaces) - 1);
+          pad -= sizeof (spaces) - 1;
+        }
+      out_write (dat, spaces, pad);
+    }
+  out_write (dat, s, len);
+}
+
+void
+out_uint (Bit_Chain *dat, uint64_t value, int width)
+{
+  char buf[24];
+  char *p = &buf[sizeof (buf)];
+  do
+    {
+      *--p = '0' + (char)(value % 10);
+      value /= 10;
+    }
+  while (value);
+  out_pad (dat, p, (int)(&buf[sizeof (buf)] - p), width);
+}
+
+void
+out_int (Bit_Chain *dat, int64_t value, int width)
+{
+  char buf[24];
+  char *p = &buf[sizeof (buf)];
+  uint64_t u = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+  do
+    {
+      *--p = '0' + (char)(u % 10);
+      u /= 10;
+    }
+  while (u);
+  if (value < 0)
+    *--p = '-';
+  out_pad (dat, p, (int)(&buf[sizeof (buf)] - p), width);
+}
+
+void
+out_hex (Bit_Chain *dat, uint64_t value)
+{
+  static const char hex[] = "0123456789ABCDEF";
+  char buf[16];
+  char *p = &buf[sizeof (buf)];
+  do
+    {
+      *--p = hex[value & 15];
+      value >>= 4;
+    }
+  while (value);
+  out_write (dat, p, &buf[sizeof (buf)] - p);
+}
+
+/*--------------------------------------------------------------------------------
+ * Grisu2
+ */
+
+typedef struct _diy_fp
+{
+  uint64_t f;
+  int e;
+} diy_fp;
+
+/* 10^k as normalized diy_fp for k = -348, -340, ..., 340,
+   rounded to nearest */
+static const uint64_t cached_powers_f[] = {
+  0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+  0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+  0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+  0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+  0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+  0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+  0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+  0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+  0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+  0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+  0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+  0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+  0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+  0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+  0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+  0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+  0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+  0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+  0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+  0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+  0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+  0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+  0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+  0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+  0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+  0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+  0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+  0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+  0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+static const int16_t cached_powers_e[] = {
+  -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954,
+  -927, -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635,
+  -608, -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316,
+  -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30, 56,
+  83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402, 428, 455,
+  481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800, 827, 853,
+  880, 907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const uint64_t pow10_64[] = { 1ULL,
+                                     10ULL,
+                                     100ULL,
+                                     1000ULL,
+                                     10000ULL,
+                                     100000ULL,
+                                     1000000ULL,
+                                     10000000ULL,
+                                     100000000ULL,
+                                     1000000000ULL,
+                                     10000000000ULL,
+                                     100000000000ULL,
+                                     1000000000000ULL,
+                                     10000000000000ULL,
+                                     100000000000000ULL,
+                                     1000000000000000ULL,
+                                     10000000000000000ULL,
+                                     100000000000000000ULL,
+                                     1000000000000000000ULL,
+                                     10000000000000000000ULL };
+
+#define DP_HIDDEN_BIT 0x0010000000000000ULL
+#define DP_FRAC_MASK 0x000FFFFFFFFFFFFFULL
+
+// rounded 64x64 multiplication, keeping the upper half
+static diy_fp
+diy_fp_mul (const diy_fp x, const diy_fp y)
+{
+  const uint64_t M32 = 0xFFFFFFFFULL;
+  const uint64_t a = x.f >> 32, b = x.f & M32;
+  const uint64_t c = y.f >> 32, d = y.f & M32;
+  const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+  uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+  diy_fp r;
+  tmp += 1U << 31;
+  r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+  r.e = x.e + y.e + 64;
+  return r;
+}
+
+static void
+grisu_round (char *digits, int len, uint64_t delta, uint64_t rest,
+             uint64_t ten_kappa, uint64_t wp_w)
+{
+  while (rest < wp_w && delta - rest >= ten_kappa
+         && (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+      digits[len - 1]--;
+      rest += ten_kappa;
+    }
+}
+
+static int
+digit_gen (const diy_fp W, const diy_fp Mp, uint64_t delta, char *digits,
+           int *K)
+{
+  const int shift = -Mp.e;
+  const uint64_t one = 1ULL << shift;
+  const uint64_t wp_w = Mp.f - W.f;
+  uint32_t p1 = (uint32_t)(Mp.f >> shift);
+  uint64_t p2 = Mp.f & (one - 1);
+  int kappa = 1;
+  int len = 0;
+
+  while (kappa < 10 && p1 >= pow10_64[kappa])
+    kappa++;
+  while (kappa > 0)
+    {
+      const uint32_t p = (uint32_t)pow10_64[kappa - 1];
+      const uint32_t d = p1 / p;
+      uint64_t tmp;
+      p1 %= p;
+      if (d || len)
+        digits[len++] = '0' + (char)d;
+      kappa--;
+      tmp = ((uint64_t)p1 << shift) + p2;
+      if (tmp <= delta)
+        {
+          *K += kappa;
+          grisu_round (digits, len, delta, tmp, pow10_64[kappa] << shift,
+                       wp_w);
+          return len;
+        }
+    }
+  for (;;)
+    {
+      char d;
+      p2 *= 10;
+      delta *= 10;
+      d = (char)(p2 >> shift);
+      if (d || len)
+        digits[len++] = '0' + d;
+      p2 &= one - 1;
+      kappa--;
+      if (p2 < delta)
+        {
+          *K += kappa;
+          grisu_round (digits, len, delta, p2, one,
+                       -kappa < 20 ? wp_w * pow10_64[-kappa] : 0);
+          return len;
+        }
+    }
+}
+
+/* value > 0 and finite. value = digits * 10^K. Returns the number of
+   digits, max 17. */
+static int
+grisu2 (const double value, char *digits, int *K)
+{
+  union
+  {
+    double d;
+    uint64_t u;
+  } u;
+  int biased_e;
+  diy_fp v, w, pl, mi, c_mk;
+  double dk;
+  int k;
+  unsigned index;
+
+  u.d = value;
+  biased_e = (int)((u.u >> 52) & 0x7FF);
+  if (biased_e)
+    {
+      v.f = (u.u & DP_FRAC_MASK) + DP_HIDDEN_BIT;
+      v.e = biased_e - 1075;
+    }
+  else
+    {
+      v.f = u.u & DP_FRAC_MASK;
+      v.e = -1074;
+    }
+  // the normalized boundaries m+ and m-
+  pl.f = (v.f << 1) + 1;
+  pl.e = v.e - 1;
+  while (!(pl.f & (DP_HIDDEN_BIT << 1)))
+    {
+      pl.f <<= 1;
+      pl.e--;
+    }
+  pl.f <<= 10;
+  pl.e -= 10;
+  if (v.f == DP_HIDDEN_BIT)
+    {
+      mi.f = (v.f << 2) - 1;
+      mi.e = v.e - 2;
+    }
+  else
+    {
+      mi.f = (v.f << 1) - 1;
+      mi.e = v.e - 1;
+    }
+  mi.f <<= mi.e - pl.e;
+  mi.e = pl.e;
+  w = v;
+  while (!(w.f & (1ULL << 63)))
+    {
+      w.f <<= 1;
+      w.e--;
+    }
+
+  // the cached power of ten which brings the exponent into [-60,-32]
+  dk = (-61 - pl.e) * 0.30102999566398114 + 347;
+  k = (int)dk;
+  if (dk - k > 0.0)
+    k++;
+  index = (unsigned)((k >> 3) + 1);
+  *K = -(-348 + (int)(index << 3));
+  c_mk.f = cached_powers_f[index];
+  c_mk.e = cached_powers_e[index];
+
+  w = diy_fp_mul (w, c_mk);
+  pl = diy_fp_mul (pl, c_mk);
+  mi = diy_fp_mul (mi, c_mk);
+  mi.f++;
+  pl.f--;
+  return digit_gen (w, pl, pl.f - mi.f, digits, K);
+}
+
+/* Grisu2 is not always the shortest. Its 17 digits are often also
+   representable with 16, as %.16G would print them. Try both neighbours
+   of the 16 digit prefix, the nearer first. */
+static int
+shorten17 (const double value, char *digits, int *K)
+{
+  char s[24];
+  uint64_t d16 = 0;
+  int i;
+  // strtod sets ERANGE on subnormals, but callers check errno
+  const int saved_errno = errno;
+  for (i = 0; i < 16; i++)
+    d16 = d16 * 10 + (digits[i] - '0');
+  for (i = 0; i < 2; i++)
+    {
+      const int up = (digits[16] >= '5') ^ i;
+      uint64_t c = d16 + up;
+      int k = *K + 1, n = 16, e;
+      char *p;
+      if (c == pow10_64[16])
+        {
+          c = 1;
+          k += 16;
+          n = 1;
+        }
+      for (p = &s[n]; p > s; c /= 10)
+        *--p = '0' + (char)(c % 10);
+      p = &s[n];
+      *p++ = 'e';
+      e = k < 0 ? -k : k;
+      if (k < 0)
+        *p++ = '-';
+      if (e >= 100)
+        *p++ = '0' + (char)(e / 100);
+      if (e >= 10)
+        *p++ = '0' + (char)(e / 10 % 10);
+      *p++ = '0' + (char)(e % 10);
+      *p = '\0';
+      if (strtod (s, NULL) == value)
+        {
+          errno = saved_errno;
+          memcpy (digits, s, n);
+          *K = k;
+          return n;
+        }
+    }
+  errno = saved_errno;
+  return 17;
+}
+
+static char *
+write_exponent (char *p, int e, int style)
+{
+  if (style == OUT_RD_DXF)
+    *p++ = 'E';
+  else
+    *p++ = 'e';
+  if (e < 0)
+    {
+      *p++ = '-';
+      e = -e;
+    }
+  else
+    *p++ = '+';
+  if (e >= 100)
+    {
+      *p++ = '0' + (char)(e / 100);
+      e %= 100;
+      *p++ = '0' + (char)(e / 10);
+    }
+  else if (e >= 10 || style == OUT_RD_DXF)
+    *p++ = '0' + (char)(e / 10);
+  *p++ = '0' + (char)(e % 10);
+  return p;
+}
+
+int
+out_format_rd (char *buf, double value, int style)
+{
+  char digits[20];
+  char *p = buf;
+  int len, K, kk;
+
+  if (signbit (value))
+    {
+      *p++ = '-';
+      value = -value;
+    }
+  if (value == 0.0)
+    {
+      *p++ = '0';
+      if (style == OUT_RD_JSON)
+        {
+          *p++ = '.';
+          *p++ = '0';
+        }
+      *p = '\0';
+      return (int)(p - buf);
+    }
+  len = grisu2 (value, digits, &K);
+  if (len == 17)
+    len = shorten17 (value, digits, &K);
+  while (len > 1 && digits[len - 1] == '0')
+    {
+      len--;
+      K++;
+    }
+  kk = len + K; // 10^(kk-1) <= value < 10^kk
+
+  // the %G rules with precision 16, or as JavaScript
+  if (style == OUT_RD_DXF ? (kk > -4 && kk <= 16) : (kk > -6 && kk <= 21))
+    {
+      if (kk <= 0)
+        {
+          *p++ = '0';
+          *p++ = '.';
+          memset (p, '0', -kk);
+          p += -kk;
+          memcpy (p, digits, len);
+          p += len;
+        }
+      else if (kk >= len)
+        {
+          memcpy (p, digits, len);
+          p += len;
+          memset (p, '0', kk - len);
+          p += kk - len;
+          if (style == OUT_RD_JSON)
+            {
+              *p++ = '.';
+              *p++ = '0';
+            }
+        }
+      else
+        {
+          memcpy (p, digits, kk);
+          p += kk;
+          *p++ = '.';
+          memcpy (p, &digits[kk], len - kk);
+          p += len - kk;
+        }
+    }
+  else
+    {
+      *p++ = digits[0];
+      if (len > 1)
+        {
+          *p++ = '.';
+          memcpy (p, &digits[1], len - 1);
+          p += len - 1;
+        }
+      p = write_exponent (p, kk - 1, style);
+    }
+  *p = '\0';
+  return (int)(p - buf);
+}
+
+void
+out_rd (Bit_Chain *dat, double value, int style)
+{
+  char buf[32];
+  int len;
+  if (!isfinite (value))
+    {
+      out_printf (dat, style == OUT_RD_DXF ? "%G" : "%f", value);
+      return;
+    }
+  len = out_format_rd (buf, value, style);
+  out_write (dat, buf, len);
+}
+
+/* Exact %.*f: the integer part, and the fraction f = m / 2^s rounded to
+   nearest even as m * 10^prec / 2^s in 128 bits. */
+void
+out_fixed (Bit_Chain *dat, double value, int prec)
+{
+  union
+  {
+    double d;
+    uint64_t u;
+  } u;
+  char buf[48];
+  char *p = &buf[sizeof (buf)];
+  const double a = fabs (value);
+  uint64_t ip, q = 0;
+  int i;
+
+  if (prec < 0 || prec > 17 || !(a < 9007199254740992.0)) // 2^53
+    {
+      out_printf (dat, "%.*f", prec, value);
+      return;
+    }
+  ip = (uint64_t)a;
+  u.d = a - (double)ip; // exact
+  if (u.d != 0.0)
+    {
+      const uint64_t M32 = 0xFFFFFFFFULL;
+      const int biased_e = (int)((u.u >> 52) & 0x7FF);
+      uint64_t m = u.u & DP_FRAC_MASK;
+      uint64_t p00, p01, p10, mid, lo, hi, sticky;
+      int s, round_bit;
+      if (biased_e)
+        {
+          m += DP_HIDDEN_BIT;
+          s = 1075 - biased_e; // >= 53
+        }
+      else
+        s = 1074;
+      // m * 10^prec < 2^110
+      p00 = (m & M32) * (pow10_64[prec] & M32);
+      p01 = (m & M32) * (pow10_64[prec] >> 32);
+      p10 = (m >> 32) * (pow10_64[prec] & M32);
+      mid = (p00 >> 32) + (p01 & M32) + (p10 & M32);
+      lo = (mid << 32) | (p00 & M32);
+      hi = (m >> 32) * (pow10_64[prec] >> 32) + (p01 >> 32) + (p10 >> 32)
+           + (mid >> 32);
+      if (s >= 128)
+        round_bit = 0;
+      else if (s >= 64)
+        {
+          const int t = s - 64;
+          q = hi >> t;
+          if (t)
+            {
+              round_bit = (int)((hi >> (t - 1)) & 1);
+              sticky = lo | (hi & ((1ULL << (t - 1)) - 1));
+            }
+          else
+            {
+              round_bit = (int)(lo >> 63);
+              sticky = lo & ((1ULL << 63) - 1);
+            }
+        }
+      else
+        {
+          q = (lo >> s) | (hi << (64 - s));
+          round_bit = (int)((lo >> (s - 1)) & 1);
+          sticky = lo & ((1ULL << (s - 1)) - 1);
+        }
+      // ties to the even last digit
+      if (round_bit && (sticky || ((prec ? q : ip) & 1)))
+        q++;
+      if (q == pow10_64[prec])
+        {
+          q = 0;
+          ip++;
+        }
+    }
+  for (i = 0; i < prec; i++)
+    {
+      *--p = '0' + (char)(q % 10);
+      q /= 10;
+    }
+  if (prec)
+    *--p = '.';
+  do
+    {
+      *--p = '0' + (char)(ip % 10);
+      ip /= 10;
+    }
+  while (ip);
+  if (signbit (value))
+    *--p = '-';
+  out_write (dat, p, &buf[sizeof (buf)] - p);
+}
+
+/*--------------------------------------------------------------------------------
+ * Threaded rendering
+ */
+
+#ifdef OUT_THREADS
+
+/* A run of items rendered into memory */
+typedef struct _out_run
+{
+  Out_Buf ob;
+  int error;
+  int done;
+} Out_Run;
+
+typedef struct _out_pool
+{
+  Bit_Chain dat; // template for the workers, without fh
+  Out_Render render;
+  void *arg;
+  BITCODE_BL num;
+  BITCODE_BL runsize;
+  BITCODE_BL num_runs;
+  BITCODE_BL next;    // next run to render
+  BITCODE_BL written; // runs already written by the main thread
+  BITCODE_BL window;  // max runs ahead of written, bounds the memory
+  Out_Run *runs;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+} Out_Pool;
+
+static int
+out_num_threads (const Dwg_Data *dwg, BITCODE_BL num)
+{
+  long n = 1;
+  char *probe;
+  if (!(dwg->opts & DWG_OPTS_THREADS) || num < 2 * OUT_RUN_MIN)
+    return 1;
+  probe = getenv ("LIBREDWG_THREADS");
+  if (probe)
+    n = strtol (probe, NULL, 10);
+#  ifdef _SC_NPROCESSORS_ONLN
+  else
+    n = sysconf (_SC_NPROCESSORS_ONLN);
+#  endif
+  if (n < 1)
+    return 1;
+  return n > OUT_MAX_THREADS ? OUT_MAX_THREADS : (int)n;
+}
+
+static void *
+out_worker (void *arg)
+{
+  Out_Pool *pool = (Out_Pool *)arg;
+  pthread_mutex_lock (&pool->lock);
+  while (1)
+    {
+      Bit_Chain dat;
+      Out_Run *run;
+      BITCODE_BL from, to;
+      while (pool->next < pool->num_runs
+             && pool->next >= pool->written + pool->window)
+        pthread_cond_wait (&pool->cond, &pool->lock);
+      if (pool->next >= pool->num_runs)
+        break;
+      run = &pool->runs[pool->next];
+      from = pool->next * pool->runsize;
+      to = from + pool->runsize < pool->num ? from + pool->runsize : pool->num;
+      pool->next++;
+      pthread_mutex_unlock (&pool->lock);
+
+      dat = pool->dat;
+      out_buf_begin (&dat, &run->ob);
+      if (dat.outbuf)
+        run->error = pool->render (&dat, pool->arg, from, to);
+      else
+        run->error = DWG_ERR_OUTOFMEM;
+
+      pthread_mutex_lock (&pool->lock);
+      run->done = 1;
+      pthread_cond_broadcast (&pool->cond);
+    }
+  pthread_mutex_unlock (&pool->lock);
+  return NULL;
+}
+
+int
+out_render (Bit_Chain *restrict dat, Dwg_Data *dwg, BITCODE_BL num,
+            Out_Render render, void *arg)
+{
+  Out_Pool pool;
+  pthread_t threads[OUT_MAX_THREADS];
+  int num_threads = out_num_threads (dwg, num);
+  int error = 0;
+  int i;
+  BITCODE_BL r;
+
+  if (num_threads <= 1)
+    return render (dat, arg, 0, num);
+  // resolve all refs before, the workers must not change the dwg
+  if (dwg->dirty_refs)
+    dwg_resolve_objectrefs_silent (dwg);
+
+  memset (&pool, 0, sizeof (pool));
+  pool.dat = *dat;
+  pool.dat.fh = NULL;
+  pool.dat.outbuf = NULL;
+  pool.render = render;
+  pool.arg = arg;
+  pool.num = num;
+  pool.runsize = num / (num_threads * 8);
+  if (pool.runsize < OUT_RUN_MIN)
+    pool.runsize = OUT_RUN_MIN;
+  pool.num_runs = (num + pool.runsize - 1) / pool.runsize;
+  pool.window = 2 * num_threads;
+  pool.runs = (Out_Run *)calloc (pool.num_runs, sizeof (Out_Run));
+  if (!pool.runs)
+    return render (dat, arg, 0, num);
+  pthread_mutex_init (&pool.lock, NULL);
+  pthread_cond_init (&pool.cond, NULL);
+  for (i = 0; i < num_threads; i++)
+    {
+      if (pthread_create (&threads[i], NULL, out_worker, &pool))
+        break;
+    }
+  num_threads = i;
+  if (!num_threads)
+    {
+      pthread_cond_destroy (&pool.cond);
+      pthread_mutex_destroy (&pool.lock);
+      free (pool.runs);
+      return render (dat, arg, 0, num);
+    }
+
+  // write the runs in order, as they get ready
+  for (r = 0; r < pool.num_runs; r++)
+    {
+      Out_Run *run = &pool.runs[r];
+      pthread_mutex_lock (&pool.lock);
+      while (!run->done)
+        pthread_cond_wait (&pool.cond, &pool.lock);
+      pthread_mutex_unlock (&pool.lock);
+      out_write (dat, run->ob.buf, run->ob.pos);
+      error |= run->error;
+      free (run->ob.buf);
+      run->ob.buf = NULL;
+      pthread_mutex_lock (&pool.lock);
+      pool.written = r + 1;
+      pthread_cond_broadcast (&pool.cond);
+      pthread_mutex_unlock (&pool.lock);
+    }
+
+  for (i = 0; i < num_threads; i++)
+    pthread_join (threads[i], NULL);
+  pthread_cond_destroy (&pool.cond);
+  pthread_mutex_destroy (&pool.lock);
+  free (pool.runs);
+  return error;
+}
+
+#else
+
+int
+out_render (Bit_Chain *restrict dat, Dwg_Data *dwg, BITCODE_BL num,
+            Out_Render render, void *arg)
+{
+  (void)dwg;
+  return render (dat, arg, 0, num);
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*****************************************************************************/
+/*  LibreDWG - free implementation of the DWG file format                    */
+/*                                                                           */
+/*  Copyright (C) 2026 Free Software Foundation, Inc.                        */
+/*                                                                           */
+/*  This library is free software, licensed under the terms of the GNU       */
+/*  General Public License as published by the Free Software Foundation,     */
+/*  either version 3 of the License, or (at your option) any later version.  */
+/*  You should have received a copy of the GNU General Public License        */
+/*  along with this program.  If not, see <http://www.gnu.org/licenses/>.    */
+/*****************************************************************************/
+
+#ifndef OUT_BUF_H
+#define OUT_BUF_H
+
+/*
+ * out_buf.h: buffered text output for the DXF, JSON and GeoJSON writers.
+ *            Writes go to a user-space buffer flushed to dat->fh in big
+ *            chunks, ints and handles are formatted directly, and doubles
+ *            with the shortest string which reads back to the same value
+ *            (Grisu2).
+ *            Without an active buffer all writes go straight to dat->fh,
+ *            without dat->fh the buffer grows in memory.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "common.h"
+#include "bits.h"
+
+#define OUT_BUF_SIZE 65536
+
+#if defined(HAVE_PTHREAD_H) && defined(THREAD_LOCAL_SUPPORTED)
+#  define OUT_THREADS
+#endif
+/* min. number of items per run, and max. number of worker threads */
+#define OUT_RUN_MIN 64
+#define OUT_MAX_THREADS 64
+
+/* styles for out_rd() */
+#define OUT_RD_DXF 0  /* as %G: 1E+16, 0.5, 1 */
+#define OUT_RD_JSON 1 /* 1e+21, 0.5, 1.0 */
+
+typedef struct _out_buf
+{
+  char *buf;
+  size_t pos;
+  size_t size;
+} Out_Buf;
+
+/* Start and end buffering the writes to dat->fh */
+void out_buf_begin (Bit_Chain *restrict dat, Out_Buf *restrict ob);
+void out_buf_end (Bit_Chain *restrict dat, Out_Buf *restrict ob);
+void out_flush (Bit_Chain *dat);
+
+void out_write (Bit_Chain *restrict dat, const char *restrict s, size_t len);
+void out_printf (Bit_Chain *restrict dat, const char *restrict fmt, ...)
+    ATTRIBUTE_FORMAT (2, 3);
+/* as %*d and %*u, right-aligned to width */
+void out_int (Bit_Chain *dat, int64_t value, int width);
+void out_uint (Bit_Chain *dat, uint64_t value, int width);
+/* as %X */
+void out_hex (Bit_Chain *dat, uint64_t value);
+/* shortest round-trip double */
+void out_rd (Bit_Chain *dat, double value, int style);
+/* as %.*f */
+void out_fixed (Bit_Chain *dat, double value, int prec);
+
+/* Writes the shortest round-trip representation of a finite value
+   into buf[32]. Returns the length. */
+int out_format_rd (char *buf, double value, int style);
+
+/* Renders the items [from, to) of a section, e.g. objects */
+typedef int (*Out_Render) (Bit_Chain *restrict dat, void *arg,
+                           BITCODE_BL from, BITCODE_BL to);
+
+/* Calls render for all num items. With DWG_OPTS_THREADS the items are
+   split into runs, rendered into memory buffers by worker threads, and
+   written to dat in the original order. The render function may only
+   change its own objects, and thread-local state. */
+int out_render (Bit_Chain *restrict dat, Dwg_Data *dwg, BITCODE_BL num,
+                Out_Render render, void *arg);
+
+static inline void
+out_putc (Bit_Chain *dat, const char c)
+{
+  Out_Buf *ob = dat->outbuf;
+  if (ob && ob->pos < ob->size)
+    ob->buf[ob->pos++] = c;
+  else
+    out_write (dat, &c, 1);
+}
+
+static inline void
+out_puts (Bit_Chain *restrict dat, const char *restrict s)
+{
+  out_write (dat, s, strlen (s));
+}
+
+#endif
@@ -39,15 +39,16 @@
 #include "decode.h"
 #include "encode.h"
 #include "out_dxf.h"
+#include "out_buf.h"
 
 static unsigned int loglevel;
 #define DWG_LOGLEVEL loglevel
 #include "logging.h"
 
 /* the current version per spec block */
-static unsigned int cur_ver = 0;
-static char buf[255];
-static BITCODE_BL rcount1, rcount2;
+static THREAD_LOCAL unsigned int cur_ver = 0;
+static THREAD_LOCAL char buf[255];
+static THREAD_LOCAL BITCODE_BL rcount1, rcount2;
 
 // imported
 char *dwg_obj_table_get_name (const Dwg_Object *restrict obj,
@@ -127,15 +128,13 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
             if ((j % 127) == 0)                                               \
               {                                                               \
                 if (j)                                                        \
-                  fprintf (dat->fh, "\r\n");                                  \
+                  out_puts (dat, "\r\n");                                     \
                 GROUP (dxf);                                                  \
               }                                                               \
-            if (value)                                                        \
-              fprintf (dat->fh, "%02X", ((unsigned char *)value)[j]);         \
-            else                                                              \
-              fprintf (dat->fh, "%02X", 0);                                   \
+            dxf_print_hexbyte (dat,                                           \
+                               value ? ((unsigned char *)value)[j] : 0);      \
           }                                                                   \
-        fprintf (dat->fh, "\r\n");                                            \
+        out_puts (dat, "\r\n");                                               \
       }                                                                       \
   }
 #define FIELD_BINARY(name, size, dxf)                                         \
@@ -148,8 +147,8 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
 #define VALUE_HANDLE(ref, nam, handle_code, dxf)                              \
   if (dxf)                                                                    \
     {                                                                         \
-      fprintf (dat->fh, "%3i\r\n" FMT_H "\r\n", dxf,                          \
-               ref ? ((BITCODE_H)ref)->absolute_ref : 0UL);                   \
+      dxf_print_handle (dat, dxf,                                             \
+                        ref ? ((BITCODE_H)ref)->absolute_ref : 0UL);          \
     }
 // the name in the table, referenced by the handle
 // names on: 6 7 8. which else? there are more styles: plot, ...
@@ -158,7 +157,7 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
   if (dxf != 0)                                                               \
     {                                                                         \
       if (!_obj->nam)                                                         \
-        fprintf (dat->fh, "%3i\r\n0\r\n", dxf);                               \
+        dxf_print_handle (dat, dxf, 0);                                       \
       else if (dxf == 6)                                                      \
         FIELD_HANDLE_NAME (nam, dxf, LTYPE)                                   \
       else if (dxf == 2)                                                      \
@@ -170,14 +169,14 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
       else if (dxf == 8)                                                      \
         FIELD_HANDLE_NAME (nam, dxf, LAYER)                                   \
       else if (dat->version >= R_13b1)                                        \
-        fprintf (dat->fh, "%3i\r\n" FMT_H "\r\n", dxf,                        \
-                 _obj->nam->obj ? _obj->nam->absolute_ref : 0UL);             \
+        dxf_print_handle (dat, dxf,                                           \
+                          _obj->nam->obj ? _obj->nam->absolute_ref : 0UL);    \
     }
 #define SUB_FIELD_HANDLE(o, nam, handle_code, dxf)                            \
   if (dxf != 0)                                                               \
     {                                                                         \
       if (!_obj->o.nam)                                                       \
-        fprintf (dat->fh, "%3i\r\n0\r\n", dxf);                               \
+        dxf_print_handle (dat, dxf, 0);                                       \
       else if (dxf == 6)                                                      \
         SUB_FIELD_HANDLE_NAME (o, nam, dxf, LTYPE)                            \
       else if (dxf == 3)                                                      \
@@ -187,8 +186,8 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
       else if (dxf == 8)                                                      \
         SUB_FIELD_HANDLE_NAME (o, nam, dxf, LAYER)                            \
       else if (dat->version >= R_13b1)                                        \
-        fprintf (dat->fh, "%3i\r\n" FMT_H "\r\n", dxf,                        \
-                 _obj->o.nam->obj ? _obj->o.nam->absolute_ref : 0UL);         \
+        dxf_print_handle (dat, dxf,                                           \
+                          _obj->o.nam->obj ? _obj->o.nam->absolute_ref : 0UL);\
     }
 #define FIELD_HANDLE0(nam, handle_code, dxf)                                  \
   if (_obj->nam && _obj->nam->absolute_ref)                                   \
@@ -203,11 +202,11 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
 #define HEADER_9(nam)                                                         \
   {                                                                           \
     GROUP (9);                                                                \
-    fprintf (dat->fh, "$%s\r\n", #nam);                                       \
+    out_printf (dat, "$%s\r\n", #nam);                                        \
   }
 #define VALUE_H(value, dxf)                                                   \
   if (dxf)                                                                    \
-  fprintf (dat->fh, "%3i\r\n" FMT_H "\r\n", dxf, value)
+  dxf_print_handle (dat, dxf, value)
 #define HEADER_H(nam, dxf)                                                    \
   {                                                                           \
     HEADER_9 (nam);                                                           \
@@ -282,19 +281,19 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
 
 #define SECTION(section)                                                      \
   LOG_INFO ("\nSection " #section "\n")                                       \
-  fprintf (dat->fh, "  0\r\nSECTION\r\n  2\r\n" #section "\r\n")
-#define ENDSEC() fprintf (dat->fh, "  0\r\nENDSEC\r\n")
-#define TABLE(table) fprintf (dat->fh, "  0\r\nTABLE\r\n  2\r\n" #table "\r\n")
-#define ENDTAB() fprintf (dat->fh, "  0\r\nENDTAB\r\n")
-#define RECORD(record) fprintf (dat->fh, "  0\r\n" #record "\r\n")
-#define record(record) fprintf (dat->fh, "  0\r\n%s\r\n", record)
+  out_puts (dat, "  0\r\nSECTION\r\n  2\r\n" #section "\r\n")
+#define ENDSEC() out_puts (dat, "  0\r\nENDSEC\r\n")
+#define TABLE(table) out_puts (dat, "  0\r\nTABLE\r\n  2\r\n" #table "\r\n")
+#define ENDTAB() out_puts (dat, "  0\r\nENDTAB\r\n")
+#define RECORD(record) out_puts (dat, "  0\r\n" #record "\r\n")
+#define record(record) out_printf (dat, "  0\r\n%s\r\n", record)
 #define SUBCLASS(text)                                                        \
   if (dat->version >= R_13b1)                                                 \
     {                                                                         \
       VALUE_TV (#text, 100);                                                  \
     }
 
-#define GROUP(dxf) fprintf (dat->fh, "%3i\r\n", dxf)
+#define GROUP(dxf) dxf_print_group (dat, dxf)
 /* avoid empty numbers, and fixup some bad %f GNU/BSD libc formatting */
 #define VALUE(value, type, dxf)                                               \
   if (dxf)                                                                    \
@@ -305,64 +304,73 @@ static void dxf_CMC (Bit_Chain *restrict dat, Dwg_Color *restrict color,
         {                                                                     \
           dxf_print_rd (dat, (double)(value), dxf);                           \
         }                                                                     \
-      else                                                                    \
+      else if ((90 <= dxf && dxf < 100) || strEQc (_fmt, "%6i"))            \
         {                                                                     \
           /* -Wpointer-to-int-cast */                                         \
           const int32_t _si = (int32_t)(intptr_t)(value);                     \
+          GROUP (dxf);                                                        \
+          out_int (dat, _si, dxf >= 90 && dxf < 100 ? 9 : 6);                 \
+          out_write (dat, "\r\n", 2);                                         \
+        }                                                                     \
+      else                                                                    \
+        {                                                                     \
           GROUP (dxf);                                                        \
           GCC46_DIAG_IGNORE (-Wformat-nonliteral)                             \
           snprintf (buf, 255, _fmt, value);                                   \
           GCC46_DIAG_RESTORE                                                  \
           /* not a string, empty num. must be zero */                         \
           if (strEQc (_fmt, "%s") && !*buf)                                   \
-            fprintf (dat->fh, "0\r\n");                                       \
-          else if (90 <= dxf && dxf < 100)                                    \
-            {                                                                 \
-              fprintf (dat->fh, "%9i\r\n", _si);                              \
-            }                                                                 \
+            out_puts (dat, "0\r\n");                                          \
           else                                                                \
-            fprintf (dat->fh, "%s\r\n", buf);                                 \
+            out_printf (dat, "%s\r\n", buf);                                  \
         }                                                                     \
     }
 
+static void
+dxf_print_group (Bit_Chain *dat, int dxf)
+{
+  out_int (dat, dxf, 3);
+  out_write (dat, "\r\n", 2);
+}
+
+static void
+dxf_print_handle (Bit_Chain *dat, int dxf, BITCODE_RLL value)
+{
+  dxf_print_group (dat, dxf);
+  out_hex (dat, value);
+  out_write (dat, "\r\n", 2);
+}
+
+static void
+dxf_print_hexbyte (Bit_Chain *dat, unsigned char c)
+{
+  static const char hex[] = "0123456789ABCDEF";
+  out_putc (dat, hex[c >> 4]);
+  out_putc (dat, hex[c & 15]);
+}
+
+// As DXF_FORMAT_FLT, but with the shortest digits which read back
+// to the same value, up to 17.
 static void
 dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
 {
   if (dxf)
     {
-      char _buf[128];
-      char *comma;
-      fprintf (dat->fh, "%3i\r\n", dxf);
+      dxf_print_group (dat, dxf);
 #ifndef DEBUG_CLASSES
       if (bit_isnan (value))
         value = 0.0;
 #endif
-      snprintf (_buf, 127, DXF_FORMAT_FLT, value);
-      comma = strrchr (_buf, '.');
-      if (0 && comma) // reduce precision
-        {
-          size_t k = strlen (_buf);
-          if (k > 0 && (_buf[k - 1] == '0' || _buf[k - 1] == ' '))
-            for (k--; k > 1 && _buf[k - 1] != '.'
-                      && (_buf[k] == '0' || _buf[k] == ' ');
-                 k--)
-              _buf[k] = '\0';
-          // max len 17 after-comma places, resp. 18 with -
-          if (value < 0.0)
-            _buf[DXF_FLT_MAXLEN + 1] = '\0';
-          else
-            _buf[DXF_FLT_MAXLEN] = '\0';
-          fprintf (dat->fh, "%s\r\n", _buf);
-        }
-      else
-        fprintf (dat->fh, "%s\r\n", _buf);
+      out_rd (dat, value, OUT_RD_DXF);
+      out_write (dat, "\r\n", 2);
     }
 }
 #define VALUE_BSd(value, dxf)                                                 \
   if (dxf)                                                                    \
     {                                                                         \
       GROUP (dxf);                                                            \
-      fprintf (dat->fh, "%6i\r\n", value);                                    \
+      out_int (dat, value, 6);                                                \
+      out_write (dat, "\r\n", 2);                                             \
     }
 #define VALUE_RD(value, dxf) dxf_print_rd (dat, value, dxf)
 #define VALUE_B(value, dxf)                                                   \
@@ -370,9 +378,9 @@ dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
     {                                                                         \
       GROUP (dxf);                                                            \
       if (value == 0)                                                         \
-        fprintf (dat->fh, "     0\r\n");                                      \
+        out_puts (dat, "     0\r\n");                                         \
       else                                                                    \
-        fprintf (dat->fh, "     1\r\n");                                      \
+        out_puts (dat, "     1\r\n");                                         \
     }
 
 #define FIELD_HANDLE_NAME(nam, dxf, table)                                    \
@@ -387,11 +395,11 @@ dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
         char *name = dwg_handle_name ((Dwg_Data *)dwg, #table, ref);          \
         if (name)                                                             \
           {                                                                   \
-            fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);                    \
+            out_printf (dat, "%3i\r\n%s\r\n", dxf, name);                     \
             free (name);                                                      \
           }                                                                   \
         else                                                                  \
-          fprintf (dat->fh, "%3i\r\n\r\n", dxf);                              \
+          out_printf (dat, "%3i\r\n\r\n", dxf);                               \
       }                                                                       \
     else                                                                      \
       {                                                                       \
@@ -410,11 +418,11 @@ dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
         char *name = dwg_handle_name ((Dwg_Data *)dwg, #table, ref);          \
         if (name)                                                             \
           {                                                                   \
-            fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);                    \
+            out_printf (dat, "%3i\r\n%s\r\n", dxf, name);                     \
             free (name);                                                      \
           }                                                                   \
         else                                                                  \
-          fprintf (dat->fh, "%3i\r\n\r\n", dxf);                              \
+          out_printf (dat, "%3i\r\n\r\n", dxf);                               \
       }                                                                       \
     else                                                                      \
       {                                                                       \
@@ -670,7 +678,7 @@ dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
             if (u8 && *u8)                                                    \
               {                                                               \
                 GROUP (dxf);                                                  \
-                fprintf (dat->fh, "%s\r\n", u8);                              \
+                out_printf (dat, "%s\r\n", u8);                               \
               }                                                               \
             free (u8);                                                        \
           }                                                                   \
@@ -760,7 +768,7 @@ dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
   }
 #define FIELD_TIMEBLL(nam, dxf)                                               \
   GROUP (dxf);                                                                \
-  fprintf (dat->fh, "%.09f\r\n", _obj->nam.value)
+  out_printf (dat, "%.09f\r\n", _obj->nam.value)
 #define HEADER_CMC(nam, dxf)                                                  \
   HEADER_9 (nam);                                                             \
   VALUE_RS (dwg->header_vars.nam.index, dxf)
@@ -875,32 +883,32 @@ dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
   if (dat->version >= R_13b1 && obj->tio.object->xdicobjhandle                \
       && obj->tio.object->xdicobjhandle->absolute_ref)                        \
     {                                                                         \
-      fprintf (dat->fh, "102\r\n{ACAD_XDICTIONARY\r\n");                      \
+      out_puts (dat, "102\r\n{ACAD_XDICTIONARY\r\n");                         \
       VALUE_HANDLE (obj->tio.object->xdicobjhandle, xdicobjhandle, code,      \
                     360);                                                     \
-      fprintf (dat->fh, "102\r\n}\r\n");                                      \
+      out_puts (dat, "102\r\n}\r\n");                                         \
     }
 #define _REACTORS(code)                                                       \
   if (dat->version >= R_13b1 && obj->tio.object->num_reactors                 \
       && obj->tio.object->reactors)                                           \
     {                                                                         \
-      fprintf (dat->fh, "102\r\n{ACAD_REACTORS\r\n");                         \
+      out_puts (dat, "102\r\n{ACAD_REACTORS\r\n");                            \
       for (vcount = 0; vcount < obj->tio.object->num_reactors; vcount++)      \
         { /* soft ptr */                                                      \
           VALUE_HANDLE (obj->tio.object->reactors[vcount], reactors, code,    \
                         330);                                                 \
         }                                                                     \
-      fprintf (dat->fh, "102\r\n}\r\n");                                      \
+      out_puts (dat, "102\r\n}\r\n");                                         \
     }
 #define ENT_REACTORS(code)                                                    \
   if (dat->version >= R_13b1 && _obj->num_reactors && _obj->reactors)         \
     {                                                                         \
-      fprintf (dat->fh, "102\r\n{ACAD_REACTORS\r\n");                         \
+      out_puts (dat, "102\r\n{ACAD_REACTORS\r\n");                            \
       for (vcount = 0; vcount < _obj->num_reactors; vcount++)                 \
         {                                                                     \
           VALUE_HANDLE (_obj->reactors[vcount], reactors, code, 330);         \
         }                                                                     \
-      fprintf (dat->fh, "102\r\n}\r\n");                                      \
+      out_puts (dat, "102\r\n}\r\n");                                         \
     }
 #define REACTORS(code)
 #define XDICOBJHANDLE(code)
@@ -908,10 +916,10 @@ dxf_print_rd (Bit_Chain *dat, BITCODE_RD value, int dxf)
   if (dat->version >= R_13b1 && obj->tio.entity->xdicobjhandle                \
       && obj->tio.entity->xdicobjhandle->absolute_ref)                        \
     {                                                                         \
-      fprintf (dat->fh, "102\r\n{ACAD_XDICTIONARY\r\n");                      \
+      out_puts (dat, "102\r\n{ACAD_XDICTIONARY\r\n");                         \
       VALUE_HANDLE (obj->tio.entity->xdicobjhandle, xdicobjhandle, code,      \
                     360);                                                     \
-      fprintf (dat->fh, "102\r\n}\r\n");                                      \
+      out_puts (dat, "102\r\n}\r\n");                                         \
     }
 #define BLOCK_NAME(nam, dxf) dxf_cvt_blockname (dat, _obj->nam, dxf)
 
@@ -981,7 +989,7 @@ static int dwg_dxf_TABLECONTENT (Bit_Chain *restrict dat,
     if (obj->handle.value)                                                    \
       LOG_TRACE ("handle: " FORMAT_H "\n", ARGS_H (obj->handle));             \
     if (dat->version > R_11 || dwg->header_vars.HANDLING)                     \
-      fprintf (dat->fh, "%3i\r\n" FMT_H "\r\n", 5, obj->handle.value);        \
+      dxf_print_handle (dat, 5, obj->handle.value);                           \
     error |= dxf_common_entity_handle_data (dat, obj);                        \
     error |= dwg_dxf_##token##_private (dat, hdl_dat, str_dat, obj);          \
     error |= dxf_write_eed (dat, obj->tio.object);                            \
@@ -1027,7 +1035,7 @@ static int dwg_dxf_TABLECONTENT (Bit_Chain *restrict dat,
         if (obj->fixedtype == DWG_TYPE_TABLE)                                 \
           ;                                                                   \
         else if (obj->type >= 500 && obj->dxfname)                            \
-          fprintf (dat->fh, "  0\r\n%s\r\n", obj->dxfname);                   \
+          out_printf (dat, "  0\r\n%s\r\n", obj->dxfname);                    \
         else if (obj->type == DWG_TYPE_PLACEHOLDER)                           \
           RECORD (ACDBPLACEHOLDER);                                           \
         else if (obj->fixedtype == DWG_TYPE_PROXY_OBJECT)                     \
@@ -1243,8 +1251,8 @@ dxf_fixup_string (Bit_Chain *restrict dat, char *restrict str, const int opts,
           && (strchr (str, '\n') || strchr (str, '\r')
               || strstr (str, "\\M+")))
         {
-          static char *cbuf;
-          static char _sbuf[1024] = { 0 };
+          static THREAD_LOCAL char *cbuf;
+          static THREAD_LOCAL char _sbuf[1024] = { 0 };
           const size_t origlen = strlen (str);
           long len = (long)((2 * origlen) + 1);
           bool need_free = false;
@@ -1270,8 +1278,9 @@ dxf_fixup_string (Bit_Chain *restrict dat, char *restrict str, const int opts,
             len = (long)strlen (cquote (cbuf, len, str));
             while (len > 0)
               {
-                fprintf (dat->fh, "%3d\r\n", len < 250 ? dxf : 3);
-                fprintf (dat->fh, "%.*s\r\n", len > 250 ? 250 : (int)len, cbuf);
+                dxf_print_group (dat, len < 250 ? dxf : 3);
+                out_write (dat, cbuf, len > 250 ? 250 : len);
+                out_write (dat, "\r\n", 2);
                 len -= 250;
                 cbuf += 250;
               }
@@ -1284,15 +1293,16 @@ dxf_fixup_string (Bit_Chain *restrict dat, char *restrict str, const int opts,
           long len = (long)strlen (str);
           while (len > 0)
             {
-              fprintf (dat->fh, "%3d\r\n", len < 250 ? dxf : 3);
-              fprintf (dat->fh, "%.*s\r\n", len > 250 ? 250 : (int)len, str);
+              dxf_print_group (dat, len < 250 ? dxf : 3);
+              out_write (dat, str, len > 250 ? 250 : len);
+              out_write (dat, "\r\n", 2);
               len -= 250;
               str += 250;
             }
         }
     }
   else
-    fprintf (dat->fh, "\r\n");
+    out_puts (dat, "\r\n");
 }
 
 static int
@@ -1320,7 +1330,7 @@ dxf_write_eed (Bit_Chain *restrict dat, const Dwg_Object_Object *restrict obj)
             {
             case 0:
               if (!data->u.eed_0.length)
-                fprintf (dat->fh, "1000\r\n\r\n");
+                out_puts (dat, "1000\r\n\r\n");
               else if (data->u.eed_0.is_tu)
                 VALUE_TU (data->u.eed_0_r2007.string, 1000)
               else
@@ -1334,7 +1344,7 @@ dxf_write_eed (Bit_Chain *restrict dat, const Dwg_Object_Object *restrict obj)
               break;
             case 3:
               GROUP (dxf);
-              fprintf (dat->fh, "%9" PRIu64 "\r\n", data->u.eed_3.layer);
+              out_printf (dat, "%9" PRIu64 "\r\n", data->u.eed_3.layer);
               // VALUE_RLL (data->u.eed_3.layer, dxf);
               break;
             case 4:
@@ -1545,13 +1555,12 @@ dxf_write_xdata (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
           break;
         case DWG_VT_HANDLE:
         case DWG_VT_OBJECTID:
-          fprintf (dat->fh, "%3i\r\n" FMT_H "\r\n", dxftype,
-                   rbuf->value.absref);
+          dxf_print_handle (dat, dxftype, rbuf->value.absref);
           break;
         case DWG_VT_INVALID:
           break; // skip
         default:
-          fprintf (dat->fh, "%3i\r\n\r\n", dxftype);
+          out_printf (dat, "%3i\r\n\r\n", dxftype);
           break;
         }
       rbuf = tmp;
@@ -1573,35 +1582,35 @@ dxf_cvt_tablerecord (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
       if (dat->from_version >= R_2000 && dat->version < R_2000)
         { // convert the other way round, from newer to older
           if (strEQc (name, "Standard"))
-            fprintf (dat->fh, "%3i\r\nSTANDARD\r\n", dxf);
+            out_printf (dat, "%3i\r\nSTANDARD\r\n", dxf);
           else if (strEQc (name, "ByLayer"))
-            fprintf (dat->fh, "%3i\r\nBYLAYER\r\n", dxf);
+            out_printf (dat, "%3i\r\nBYLAYER\r\n", dxf);
           else if (strEQc (name, "ByBlock"))
-            fprintf (dat->fh, "%3i\r\nBYBLOCK\r\n", dxf);
+            out_printf (dat, "%3i\r\nBYBLOCK\r\n", dxf);
           else if (strEQc (name, "*Active"))
-            fprintf (dat->fh, "%3i\r\n*ACTIVE\r\n", dxf);
+            out_printf (dat, "%3i\r\n*ACTIVE\r\n", dxf);
           else
-            fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);
+            out_printf (dat, "%3i\r\n%s\r\n", dxf, name);
         }
       else
         { // convert some standard names
           if (dat->version >= R_2000 && strEQc (name, "STANDARD"))
-            fprintf (dat->fh, "%3i\r\nStandard\r\n", dxf);
+            out_printf (dat, "%3i\r\nStandard\r\n", dxf);
           else if (dat->version >= R_2000 && strEQc (name, "BYLAYER"))
-            fprintf (dat->fh, "%3i\r\nByLayer\r\n", dxf);
+            out_printf (dat, "%3i\r\nByLayer\r\n", dxf);
           else if (dat->version >= R_2000 && strEQc (name, "BYBLOCK"))
-            fprintf (dat->fh, "%3i\r\nByBlock\r\n", dxf);
+            out_printf (dat, "%3i\r\nByBlock\r\n", dxf);
           else if (dat->version >= R_2000 && strEQc (name, "*ACTIVE"))
-            fprintf (dat->fh, "%3i\r\n*Active\r\n", dxf);
+            out_printf (dat, "%3i\r\n*Active\r\n", dxf);
           else
-            fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);
+            out_printf (dat, "%3i\r\n%s\r\n", dxf, name);
         }
       if (IS_FROM_TU (dat))
         free (name);
     }
   else
     {
-      fprintf (dat->fh, "%3i\r\n\r\n", dxf);
+      out_printf (dat, "%3i\r\n\r\n", dxf);
     }
 }
 
@@ -1616,7 +1625,7 @@ dxf_cvt_blockname (Bit_Chain *restrict dat, char *restrict name, const int dxf)
   static int gensym = 0;
   if (!name)
     {
-      fprintf (dat->fh, "%3i\r\n*U%i\r\n", dxf, gensym++);
+      out_printf (dat, "%3i\r\n*U%i\r\n", dxf, gensym++);
       return;
     }
   if (IS_FROM_TU (dat)) // r2007+ unicode names
@@ -1625,40 +1634,40 @@ dxf_cvt_blockname (Bit_Chain *restrict dat, char *restrict name, const int dxf)
     }
   if (!name || !*name)
     {
-      fprintf (dat->fh, "%3i\r\n*U%i\r\n", dxf, gensym++);
+      out_printf (dat, "%3i\r\n*U%i\r\n", dxf, gensym++);
       if (IS_FROM_TU (dat))
         free (name);
       return;
     }
   if (dat->version == dat->from_version) // no conversion
     {
-      fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);
+      out_printf (dat, "%3i\r\n%s\r\n", dxf, name);
     }
   else if (dat->version < R_13b1 && dat->from_version >= R_13b1) // to older
     {
       if (strlen (name) < 10)
-        fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);
+        out_printf (dat, "%3i\r\n%s\r\n", dxf, name);
       else if (strEQc (name, "*Model_Space"))
-        fprintf (dat->fh, "%3i\r\n$MODEL_SPACE\r\n", dxf);
+        out_printf (dat, "%3i\r\n$MODEL_SPACE\r\n", dxf);
       else if (strEQc (name, "*Paper_Space"))
-        fprintf (dat->fh, "%3i\r\n$PAPER_SPACE\r\n", dxf);
+        out_printf (dat, "%3i\r\n$PAPER_SPACE\r\n", dxf);
       else if (!memcmp (name, "*Paper_Space", sizeof ("*Paper_Space") - 1))
-        fprintf (dat->fh, "%3i\r\n$PAPER_SPACE%s\r\n", dxf, &name[12]);
+        out_printf (dat, "%3i\r\n$PAPER_SPACE%s\r\n", dxf, &name[12]);
       else
-        fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);
+        out_printf (dat, "%3i\r\n%s\r\n", dxf, name);
     }
   else if (dat->version >= R_13b1) // to newer
     {
       if (strlen (name) < 10)
-        fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);
+        out_printf (dat, "%3i\r\n%s\r\n", dxf, name);
       else if (strEQc (name, "$MODEL_SPACE"))
-        fprintf (dat->fh, "%3i\r\n*Model_Space\r\n", dxf);
+        out_printf (dat, "%3i\r\n*Model_Space\r\n", dxf);
       else if (strEQc (name, "$PAPER_SPACE"))
-        fprintf (dat->fh, "%3i\r\n*Paper_Space\r\n", dxf);
+        out_printf (dat, "%3i\r\n*Paper_Space\r\n", dxf);
       else if (!memcmp (name, "$PAPER_SPACE", sizeof ("$PAPER_SPACE") - 1))
-        fprintf (dat->fh, "%3i\r\n*Paper_Space%s\r\n", dxf, &name[12]);
+        out_printf (dat, "%3i\r\n*Paper_Space%s\r\n", dxf, &name[12]);
       else
-        fprintf (dat->fh, "%3i\r\n%s\r\n", dxf, name);
+        out_printf (dat, "%3i\r\n%s\r\n", dxf, name);
     }
   if (IS_FROM_TU (dat))
     {
@@ -1788,7 +1797,7 @@ new_encr_sat_data_line (Dwg_Entity_3DSOLID *restrict _obj, Bit_Chain *dest,
 static const char *
 SAT_boolean (const char *act_record, bool value)
 {
-  static int argc = 0;
+  static THREAD_LOCAL int argc = 0;
   if (!strEQc (act_record, "varblendsplsur") && !strEQc (act_record, "face")
       && !strEQc (act_record, "bdy_geom"))
     argc = 0;
@@ -2501,7 +2510,7 @@ dxf_3dsolid (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
                   while (caret && caret < n)
                     {
                       int lc = caret - s;
-                      fprintf (dat->fh, "%.*s^ ", lc, s);
+                      out_printf (dat, "%.*s^ ", lc, s);
                       lc++;
                       l -= lc;
                       len -= lc;
@@ -2511,9 +2520,9 @@ dxf_3dsolid (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
                   if (l > 255)
                     LOG_ERROR ("Overlong SAT line \"%s\" len=%d", s, l)
                   if (s[l - 1] == '\r')
-                    fprintf (dat->fh, "%.*s\n", l, s);
+                    out_printf (dat, "%.*s\n", l, s);
                   else
-                    fprintf (dat->fh, "%.*s\r\n", l, s);
+                    out_printf (dat, "%.*s\r\n", l, s);
                   l++;
                   len -= l;
                   s += l;
@@ -3633,6 +3642,20 @@ dxf_blocks_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   return error;
 }
 
+static int
+dxf_entities_render (Bit_Chain *restrict dat, void *arg,
+                     BITCODE_BL from, BITCODE_BL to)
+{
+  Dwg_Object **list = (Dwg_Object **)arg;
+  int error = 0;
+  for (BITCODE_BL j = from; j < to; j++)
+    {
+      int i = list[j]->index;
+      error |= dwg_dxf_object (dat, list[j], &i);
+    }
+  return error;
+}
+
 static int
 dxf_entities_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 {
@@ -3647,25 +3670,41 @@ dxf_entities_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   // how to order the entities:
   // 1. first all ms, then all ps
 #  if 1
-  // First mspace
-  obj = get_first_owned_entity (ms); // first_entity or entities[0]
-  while (obj)
-    {
-      int i = obj->index;
-      error |= dwg_dxf_object (dat, obj, &i);
-      obj = get_next_owned_block_entity (ms, obj); // until last_entity
-    }
-  // Then all pspace entities. just filter out other BLOCKS entities
-  if (ps)
-    {
-      obj = get_first_owned_entity (ps);
-      while (obj)
-        {
-          int i = obj->index;
-          error |= dwg_dxf_object (dat, obj, &i);
-          obj = get_next_owned_block_entity (ps, obj);
-        }
-    }
+  {
+    // collect them first, for out_render
+    BITCODE_BL num = 0;
+    Dwg_Object **list;
+    for (obj = get_first_owned_entity (ms); obj;
+         obj = get_next_owned_block_entity (ms, obj))
+      num++;
+    if (ps)
+      for (obj = get_first_owned_entity (ps); obj;
+           obj = get_next_owned_block_entity (ps, obj))
+        num++;
+    list = (Dwg_Object **)malloc ((num ? num : 1) * sizeof (Dwg_Object *));
+    if (!list)
+      return DWG_ERR_OUTOFMEM;
+    num = 0;
+    // First mspace
+    obj = get_first_owned_entity (ms); // first_entity or entities[0]
+    while (obj)
+      {
+        list[num++] = obj;
+        obj = get_next_owned_block_entity (ms, obj); // until last_entity
+      }
+    // Then all pspace entities. just filter out other BLOCKS entities
+    if (ps)
+      {
+        obj = get_first_owned_entity (ps);
+        while (obj)
+          {
+            list[num++] = obj;
+            obj = get_next_owned_block_entity (ps, obj);
+          }
+      }
+    error |= out_render (dat, dwg, num, dxf_entities_render, list);
+    free (list);
+  }
 #  elif 0
   // 2. all entities in iteration order. filter out not owned by ms or ps
   // entities.
@@ -3779,6 +3818,7 @@ EXPORT int
 dwg_write_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 {
   const int minimal = dwg->opts & DWG_OPTS_MINIMAL;
+  Out_Buf ob;
   // struct Dwg_Header *obj = &dwg->header;
 
   loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
@@ -3789,6 +3829,7 @@ dwg_write_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   if (dwg->header.version <= R_2000 && dwg->header.from_version > R_2000)
     dwg_fixup_BLOCKS_entities (dwg);
 
+  out_buf_begin (dat, &ob);
   VALUE_TV (PACKAGE_STRING, 999);
 
   // A minimal header requires only $ACADVER, $HANDSEED, and then ENTITIES
@@ -3837,8 +3878,10 @@ dwg_write_dxf (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
     }
   RECORD (EOF);
 
+  out_buf_end (dat, &ob);
   return 0;
 fail:
+  out_buf_end (dat, &ob);
   return 1;
 }
 AFL_GCC_POP
@@ -43,6 +43,7 @@
 #include "dwg.h"
 #include "decode.h"
 #include "out_json.h"
+#include "out_buf.h"
 #include "geom.h"
 
 /* the current version per spec block */
@@ -94,51 +95,51 @@
 #define PREFIX                                                                \
   for (int _i = 0; _i < dat->bit; _i++)                                       \
     {                                                                         \
-      fprintf (dat->fh, "  ");                                                \
+      out_write (dat, "  ", 2);                                               \
     }
 #define ARRAY                                                                 \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "[\n");                                          \
+    PREFIX out_puts (dat, "[\n");                                             \
     dat->bit++;                                                               \
   }
 #define SAMEARRAY                                                             \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "[");                                            \
+    PREFIX out_puts (dat, "[");                                               \
     dat->bit++;                                                               \
   }
 #define ENDARRAY                                                              \
   {                                                                           \
     dat->bit--;                                                               \
-    PREFIX fprintf (dat->fh, "],\n");                                         \
+    PREFIX out_puts (dat, "],\n");                                            \
   }
 #define LASTENDARRAY                                                          \
   {                                                                           \
     dat->bit--;                                                               \
-    PREFIX fprintf (dat->fh, "]\n");                                          \
+    PREFIX out_puts (dat, "]\n");                                             \
   }
 #define HASH                                                                  \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "{\n");                                          \
+    PREFIX out_puts (dat, "{\n");                                             \
     dat->bit++;                                                               \
   }
 #define SAMEHASH                                                              \
   {                                                                           \
-    fprintf (dat->fh, "{\n");                                                 \
+    out_puts (dat, "{\n");                                                    \
     dat->bit++;                                                               \
   }
 #define ENDHASH                                                               \
   {                                                                           \
     dat->bit--;                                                               \
-    PREFIX fprintf (dat->fh, "},\n");                                         \
+    PREFIX out_puts (dat, "},\n");                                            \
   }
 #define LASTENDHASH                                                           \
   {                                                                           \
     dat->bit--;                                                               \
-    PREFIX fprintf (dat->fh, "}\n");                                          \
+    PREFIX out_puts (dat, "}\n");                                             \
   }
 #define SECTION(name)                                                         \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "\"%s\": [\n", #name);                           \
+    PREFIX out_printf (dat, "\"%s\": [\n", #name);                            \
     dat->bit++;                                                               \
   }
 #define ENDSEC() ENDARRAY
@@ -152,15 +153,15 @@
       {                                                                       \
         const size_t _len = 6 * len + 1;                                      \
         char _buf[256];                                                       \
-        PREFIX fprintf (dat->fh, "\"" #name "\": \"%s\",\n",                  \
-                        json_cquote (_buf, str, _len, dat->codepage));        \
+        PREFIX out_printf (dat, "\"" #name "\": \"%s\",\n",                   \
+                           json_cquote (_buf, str, _len, dat->codepage));     \
       }                                                                       \
     else                                                                      \
       {                                                                       \
         const size_t _len = 6 * len + 1;                                      \
         char *_buf = (char *)malloc (_len);                                   \
-        PREFIX fprintf (dat->fh, "\"" #name "\": \"%s\",\n",                  \
-                        json_cquote (_buf, str, _len, dat->codepage));        \
+        PREFIX out_printf (dat, "\"" #name "\": \"%s\",\n",                   \
+                           json_cquote (_buf, str, _len, dat->codepage));     \
         free (_buf);                                                          \
       }                                                                       \
   }
@@ -169,29 +170,29 @@
   PAIR_Sc (name, str)
 #define PAIR_D(name, value)                                                   \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "\"" #name "\": %d,\n", value);                  \
+    PREFIX out_printf (dat, "\"" #name "\": %d,\n", value);                   \
   }
 // guaranteed non-null str
 #define LASTPAIR_Sc(name, value)                                              \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "\"" #name "\": \"%s\"\n", value);               \
+    PREFIX out_printf (dat, "\"" #name "\": \"%s\"\n", value);                \
   }
 #define LASTPAIR_S(name, value)                                               \
   if (value)                                                                  \
     {                                                                         \
-      PREFIX fprintf (dat->fh, "\"" #name "\": \"%s\"\n", value);             \
+      PREFIX out_printf (dat, "\"" #name "\": \"%s\"\n", value);              \
     }
 #define PAIR_NULL(name)                                                       \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "\"" #name "\": null,\n");                       \
+    PREFIX out_puts (dat, "\"" #name "\": null,\n");                          \
   }
 #define LASTPAIR_NULL(name)                                                   \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "\"" #name "\": null\n");                        \
+    PREFIX out_puts (dat, "\"" #name "\": null\n");                           \
   }
 #define KEY(name)                                                             \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "\"" #name "\": ");                              \
+    PREFIX out_puts (dat, "\"" #name "\": ");                                 \
   }
 #define GEOMETRY(name)                                                        \
   {                                                                           \
@@ -253,7 +254,7 @@
 #define FIELD_3BD_1(name, dxf)
 #define FIELD_DD(name, _default, dxf)
 
-#define _VALUE_RD(value) fprintf (dat->fh, FORMAT_RD, value)
+#define _VALUE_RD(value) out_fixed (dat, value, GEOJSON_PRECISION)
 #ifdef IS_RELEASE
 #  define VALUE_RD(value)                                                     \
     {                                                                         \
@@ -267,47 +268,47 @@
 #endif
 #define VALUE_2DPOINT(px, py)                                                 \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "[ ");                                           \
+    PREFIX out_puts (dat, "[ ");                                              \
     VALUE_RD (px);                                                            \
-    fprintf (dat->fh, ", ");                                                  \
+    out_puts (dat, ", ");                                                     \
     VALUE_RD (py);                                                            \
-    fprintf (dat->fh, " ],\n");                                               \
+    out_puts (dat, " ],\n");                                                  \
   }
 #define LASTVALUE_2DPOINT(px, py)                                             \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "[ ");                                           \
+    PREFIX out_puts (dat, "[ ");                                              \
     VALUE_RD (px);                                                            \
-    fprintf (dat->fh, ", ");                                                  \
+    out_puts (dat, ", ");                                                     \
     VALUE_RD (py);                                                            \
-    fprintf (dat->fh, " ]\n");                                                \
+    out_puts (dat, " ]\n");                                                   \
   }
 #define FIELD_2DPOINT(name) VALUE_2DPOINT (_obj->name.x, _obj->name.y)
 #define LASTFIELD_2DPOINT(name) LASTVALUE_2DPOINT (_obj->name.x, _obj->name.y)
 #define VALUE_3DPOINT(px, py, pz)                                             \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "[ ");                                           \
+    PREFIX out_puts (dat, "[ ");                                              \
     VALUE_RD (px);                                                            \
-    fprintf (dat->fh, ", ");                                                  \
+    out_puts (dat, ", ");                                                     \
     VALUE_RD (py);                                                            \
     if (pz != 0.0)                                                            \
       {                                                                       \
-        fprintf (dat->fh, ", ");                                              \
+        out_puts (dat, ", ");                                                 \
         VALUE_RD (pz);                                                        \
       }                                                                       \
-    fprintf (dat->fh, " ],\n");                                               \
+    out_puts (dat, " ],\n");                                                  \
   }
 #define LASTVALUE_3DPOINT(px, py, pz)                                         \
   {                                                                           \
-    PREFIX fprintf (dat->fh, "[ ");                                           \
+    PREFIX out_puts (dat, "[ ");                                              \
     VALUE_RD (px);                                                            \
-    fprintf (dat->fh, ", ");                                                  \
+    out_puts (dat, ", ");                                                     \
     VALUE_RD (py);                                                            \
     if (pz != 0.0)                                                            \
       {                                                                       \
-        fprintf (dat->fh, ", ");                                              \
+        out_puts (dat, ", ");                                                 \
         VALUE_RD (pz);                                                        \
       }                                                                       \
-    fprintf (dat->fh, " ]\n");                                                \
+    out_puts (dat, " ]\n");                                                   \
   }
 #define FIELD_3DPOINT(name)                                                   \
   {                                                                           \
@@ -334,9 +335,9 @@
   ARRAY;                                                                      \
   for (vcount = 0; vcount < (BITCODE_BL)size; vcount++)                       \
     {                                                                         \
-      PREFIX fprintf (dat->fh, "\"" #name "\": " FORMAT_##type "%s\n",        \
-                      _obj->name[vcount],                                     \
-                      vcount == (BITCODE_BL)size - 1 ? "" : ",");             \
+      PREFIX out_printf (dat, "\"" #name "\": " FORMAT_##type "%s\n",         \
+                         _obj->name[vcount],                                  \
+                         vcount == (BITCODE_BL)size - 1 ? "" : ",");          \
     }                                                                         \
   ENDARRAY;
 
@@ -346,9 +347,9 @@
     {                                                                         \
       for (vcount = 0; vcount < (BITCODE_BL)_obj->size; vcount++)             \
         {                                                                     \
-          PREFIX fprintf (dat->fh, "\"" #name "\": \"%s\"%s\n",               \
-                          _obj->name[vcount],                                 \
-                          vcount == (BITCODE_BL)_obj->size - 1 ? "" : ",");   \
+          PREFIX out_printf (dat, "\"" #name "\": \"%s\"%s\n",                \
+                             _obj->name[vcount],                              \
+                             vcount == (BITCODE_BL)_obj->size - 1 ? "" : ","); \
         }                                                                     \
     }                                                                         \
   else                                                                        \
@@ -1023,10 +1024,12 @@ dwg_write_geojson (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   // const int minimal = dwg->opts & DWG_OPTS_MINIMAL;
   char date[12] = "YYYY-MM-DD";
   time_t rawtime;
+  Out_Buf ob;
 
   if (!dwg->num_objects || !dat->fh)
-    goto fail;
+    return 1;
 
+  out_buf_begin (dat, &ob);
   HASH;
   PAIR_Sc (type, "FeatureCollection");
 
@@ -1052,8 +1055,10 @@ dwg_write_geojson (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   LASTENDHASH;
 
   LASTENDHASH;
+  out_buf_end (dat, &ob);
   return 0;
 fail:
+  out_buf_end (dat, &ob);
   return 1;
 }
 
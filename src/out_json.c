@@ -33,13 +33,14 @@
 #include "dwg.h"
 #include "decode.h"
 #include "out_json.h"
+#include "out_buf.h"
 
 #define DWG_LOGLEVEL DWG_LOGLEVEL_NONE
 #include "logging.h"
 
 /* the current version per spec block */
-static unsigned int cur_ver = 0;
-static BITCODE_BL rcount1, rcount2;
+static THREAD_LOCAL unsigned int cur_ver = 0;
+static THREAD_LOCAL BITCODE_BL rcount1, rcount2;
 
 /* see also examples/unknown.c */
 #ifdef HAVE_NATIVE_WCHAR2
@@ -58,6 +59,11 @@ static int json_3dsolid (Bit_Chain *restrict dat,
                          const Dwg_Object *restrict obj,
                          Dwg_Entity_3DSOLID *restrict _obj);
 static void _prefix (Bit_Chain *dat);
+static void json_write_key (Bit_Chain *restrict dat, const char *restrict key);
+static void json_write_string (Bit_Chain *restrict dat,
+                               const char *restrict str);
+static void json_write_href (Bit_Chain *restrict dat,
+                             const Dwg_Object_Ref *restrict ref);
 static char *_path_field (const char *path);
 
 /*--------------------------------------------------------------------------------
@@ -79,41 +85,42 @@ static char *_path_field (const char *path);
 #define PRINTFIRST                                                            \
   {                                                                           \
     if (!ISFIRST)                                                             \
-      fprintf (dat->fh, ",%s", JSON_NL);                                      \
+      out_puts (dat, IS_MINJS ? "," : ",\n");                                 \
     else                                                                      \
       CLEARFIRST;                                                             \
   }
 #define FIRSTPREFIX PRINTFIRST PREFIX
 
-#define KEYs(nam) FIRSTPREFIX fprintf (dat->fh, "\"%s\":%s", nam, JSON_SPC)
+#define KEYs(nam) FIRSTPREFIX json_write_key (dat, nam)
 // strip path to field only
-#define KEY(nam)                                                              \
-  FIRSTPREFIX fprintf (dat->fh, "\"%s\":%s", _path_field (#nam), JSON_SPC)
+#define KEY(nam) FIRSTPREFIX json_write_key (dat, _path_field (#nam))
 
 #define ARRAY                                                                 \
   {                                                                           \
-    fprintf (dat->fh, "[%s", JSON_NL);                                        \
+    out_puts (dat, IS_MINJS ? "[" : "[\n");                                   \
     SETFIRST;                                                                 \
     dat->bit++;                                                               \
   }
 #define ENDARRAY                                                              \
   {                                                                           \
-    fprintf (dat->fh, "%s", JSON_NL);                                         \
+    if (!IS_MINJS)                                                            \
+      out_putc (dat, '\n');                                                   \
     dat->bit--;                                                               \
-    PREFIX fprintf (dat->fh, "]");                                            \
+    PREFIX out_puts (dat, "]");                                               \
     CLEARFIRST;                                                               \
   }
 #define HASH                                                                  \
   {                                                                           \
-    fprintf (dat->fh, "{%s", JSON_NL);                                        \
+    out_puts (dat, IS_MINJS ? "{" : "{\n");                                   \
     SETFIRST;                                                                 \
     dat->bit++;                                                               \
   }
 #define ENDHASH                                                               \
   {                                                                           \
-    fprintf (dat->fh, "%s", JSON_NL);                                         \
+    if (!IS_MINJS)                                                            \
+      out_putc (dat, '\n');                                                   \
     dat->bit--;                                                               \
-    PREFIX fprintf (dat->fh, "}");                                            \
+    PREFIX out_puts (dat, "}");                                               \
     CLEARFIRST;                                                               \
   }
 
@@ -165,7 +172,27 @@ static char *_path_field (const char *path);
 #define FORMAT_BLX FORMAT_BL
 #define FORMAT_4BITS FORMAT_RC
 
-#define VALUE(value, type, dxf) fprintf (dat->fh, FORMAT_##type, value)
+/* Integers are written directly, converted as printf would by the length
+   modifier of the format */
+#define VALUE(value, type, dxf)                                               \
+  {                                                                           \
+    const char _c = FORMAT_##type[sizeof (FORMAT_##type) - 2];                \
+    const char _l = FORMAT_##type[sizeof (FORMAT_##type) - 3];                \
+    if (_c == 'u')                                                            \
+      out_uint (dat,                                                          \
+                _l == 'l' || _l == '4' ? (uint64_t)(value)                    \
+                : _l == 'h'            ? (uint64_t)(unsigned short)(value)    \
+                                       : (uint64_t)(unsigned)(value),         \
+                0);                                                           \
+    else if (_c == 'd' || _c == 'i')                                          \
+      out_int (dat,                                                           \
+               _l == 'l' || _l == '4' ? (int64_t)(value)                      \
+               : _l == 'h'            ? (int64_t)(short)(value)               \
+                                      : (int64_t)(int)(value),                \
+               0);                                                            \
+    else                                                                      \
+      out_printf (dat, FORMAT_##type, value);                                 \
+  }
 #define VALUE_B(value, dxf) VALUE (value, B, dxf)
 #define VALUE_RC(value, dxf) VALUE (value, RC, dxf)
 #define VALUE_RS(value, dxf) VALUE (value, RS, dxf)
@@ -181,37 +208,26 @@ static char *_path_field (const char *path);
 #else
 #  define VALUE_RD(value, dxf) _VALUE_RD (value, dxf)
 #endif
-#define _VALUE_RD(value, dxf)                                                 \
-  {                                                                           \
-    char _buf[256];                                                           \
-    size_t k;                                                                 \
-    snprintf (_buf, 255, FORMAT_RD, value);                                   \
-    k = strlen (_buf);                                                        \
-    if (k > 0 && strrchr (_buf, '.') && _buf[k - 1] == '0')                   \
-      {                                                                       \
-        for (k--; k > 1 && _buf[k - 1] != '.' && _buf[k] == '0'; k--)         \
-          _buf[k] = '\0';                                                     \
-      }                                                                       \
-    fprintf (dat->fh, "%s", _buf);                                            \
-  }
+// the shortest which reads back, at least one decimal
+#define _VALUE_RD(value, dxf) out_rd (dat, value, OUT_RD_JSON)
 #define VALUE_2RD(pt, dxf)                                                    \
   {                                                                           \
-    fprintf (dat->fh, "[%s", JSON_SPC);                                       \
+    out_printf (dat, "[%s", JSON_SPC);                                        \
     VALUE_RD (pt.x, 0);                                                       \
-    fprintf (dat->fh, ",%s", JSON_SPC);                                       \
+    out_printf (dat, ",%s", JSON_SPC);                                        \
     VALUE_RD (pt.y, 0);                                                       \
-    fprintf (dat->fh, "%s]%s", JSON_SPC, JSON_SPC);                           \
+    out_printf (dat, "%s]%s", JSON_SPC, JSON_SPC);                            \
   }
 #define VALUE_2DD(pt, def, dxf) VALUE_2RD (pt, dxf)
 #define VALUE_3RD(pt, dxf)                                                    \
   {                                                                           \
-    fprintf (dat->fh, "[%s", JSON_SPC);                                       \
+    out_printf (dat, "[%s", JSON_SPC);                                        \
     VALUE_RD (pt.x, 0);                                                       \
-    fprintf (dat->fh, ",%s", JSON_SPC);                                       \
+    out_printf (dat, ",%s", JSON_SPC);                                        \
     VALUE_RD (pt.y, 0);                                                       \
-    fprintf (dat->fh, ",%s", JSON_SPC);                                       \
+    out_printf (dat, ",%s", JSON_SPC);                                        \
     VALUE_RD (pt.z, 0);                                                       \
-    fprintf (dat->fh, "%s]%s", JSON_SPC, JSON_SPC);                           \
+    out_printf (dat, "%s]%s", JSON_SPC, JSON_SPC);                            \
   }
 #define VALUE_3BD(pt, dxf) VALUE_3RD (pt, dxf)
 #define VALUE_TV(nam, dxf)
@@ -219,24 +235,24 @@ static char *_path_field (const char *path);
 #define FIELD(nam, type, dxf)                                                 \
   if (!memBEGINc (#nam, "num_"))                                              \
     {                                                                         \
-      FIRSTPREFIX fprintf (dat->fh, JSON_KEY FORMAT_##type,                   \
-                           _path_field (#nam), JSON_SPC, _obj->nam);          \
+      KEY (nam);                                                              \
+      VALUE (_obj->nam, type, dxf);                                           \
     }
 #define _FIELD(nam, type, value)                                              \
   {                                                                           \
-    FIRSTPREFIX fprintf (dat->fh, "\"" #nam "\":%s" FORMAT_##type, JSON_SPC,  \
-                         obj->nam);                                           \
+    KEYs (#nam);                                                              \
+    VALUE (obj->nam, type, 0);                                                \
   }
 #define ENT_FIELD(nam, type, value)                                           \
   {                                                                           \
-    FIRSTPREFIX fprintf (dat->fh, JSON_KEY FORMAT_##type, _path_field (#nam), \
-                         JSON_SPC, _ent->nam);                                \
+    KEY (nam);                                                                \
+    VALUE (_ent->nam, type, 0);                                               \
   }
 #define SUB_FIELD(o, nam, type, dxf)                                          \
   if (!memBEGINc (#nam, "num_"))                                              \
     {                                                                         \
-      FIRSTPREFIX fprintf (dat->fh, JSON_KEY FORMAT_##type,                   \
-                           _path_field (#nam), JSON_SPC, _obj->o.nam);        \
+      KEY (nam);                                                              \
+      VALUE (_obj->o.nam, type, dxf);                                         \
     }
 #define FIELD_CAST(nam, type, cast, dxf) FIELD (nam, cast, dxf)
 #define SUB_FIELD_CAST(o, nam, type, cast, dxf) SUB_FIELD (o, nam, cast, dxf)
@@ -244,7 +260,7 @@ static char *_path_field (const char *path);
 #define FIELD_G_TRACE(nam, type, dxf)
 #define FIELD_TEXT(nam, str)                                                  \
   {                                                                           \
-    FIRSTPREFIX fprintf (dat->fh, JSON_KEY, _path_field (#nam), JSON_SPC);    \
+    KEY (nam);                                                                \
     VALUE_TEXT ((char *)str)                                                  \
   }
 
@@ -258,21 +274,21 @@ static char *_path_field (const char *path);
           {                                                                   \
             const size_t _len = 6 * len + 1;                                  \
             char _buf[256];                                                   \
-            fprintf (dat->fh, "\"%s\"",                                       \
-                     json_cquote (_buf, str, _len, dat->codepage));           \
+            json_write_string (dat,                                           \
+                               json_cquote (_buf, str, _len, dat->codepage)); \
           }                                                                   \
         else                                                                  \
           {                                                                   \
             const size_t _len = 6 * len + 1;                                  \
             char *_buf = (char *)malloc (_len);                               \
-            fprintf (dat->fh, "\"%s\"",                                       \
-                     json_cquote (_buf, str, _len, dat->codepage));           \
+            json_write_string (dat,                                           \
+                               json_cquote (_buf, str, _len, dat->codepage)); \
             free (_buf);                                                      \
           }                                                                   \
       }                                                                       \
     else                                                                      \
       {                                                                       \
-        fprintf (dat->fh, "\"%s\"", str ? str : "");                          \
+        out_printf (dat, "\"%s\"", str ? str : "");                           \
       }                                                                       \
   }
 
@@ -282,12 +298,12 @@ static char *_path_field (const char *path);
     if (wstr)                                                                 \
       {                                                                       \
         wchar_t *_buf = malloc (6 * wcslen ((wchar_t *)wstr) + 2);            \
-        fprintf (dat->fh, "\"%ls\"", wcquote (_buf, (wchar_t *)wstr));        \
+        out_printf (dat, "\"%ls\"", wcquote (_buf, (wchar_t *)wstr));         \
         free (_buf);                                                          \
       }                                                                       \
     else                                                                      \
       {                                                                       \
-        fprintf (dat->fh, "\"%ls\"", wstr ? (wchar_t *)wstr : L"");           \
+        out_printf (dat, "\"%ls\"", wstr ? (wchar_t *)wstr : L"");            \
       }
 #else
 #  define VALUE_TEXT_TU(wstr) print_wcquote (dat, (BITCODE_TU)wstr)
@@ -300,12 +316,12 @@ static char *_path_field (const char *path);
 // may be downgraded from TV, thus shorter
 #define FIELD_TFv(nam, len, dxf)                                              \
   {                                                                           \
-    FIRSTPREFIX fprintf (dat->fh, JSON_KEY, _path_field (#nam), JSON_SPC);    \
+    FIRSTPREFIX out_printf (dat, JSON_KEY, _path_field (#nam), JSON_SPC);     \
     json_write_TFv (dat, (const BITCODE_TF)_obj->nam, len);                   \
   }
 #define FIELD_TF(nam, len, dxf)                                               \
   {                                                                           \
-    FIRSTPREFIX fprintf (dat->fh, JSON_KEY, _path_field (#nam), JSON_SPC);    \
+    FIRSTPREFIX out_printf (dat, JSON_KEY, _path_field (#nam), JSON_SPC);     \
     json_write_TF (dat, (const BITCODE_TF)_obj->nam, len);                    \
   }
 #define FIELD_TFF(nam, len, dxf) FIELD_TF (nam, len, dxf)
@@ -318,53 +334,51 @@ static char *_path_field (const char *path);
     {                                                                         \
       PRE (R_13b1)                                                            \
       {                                                                       \
-        fprintf (dat->fh, FORMAT_HREF11 "", ARGS_HREF11 (hdlptr));            \
+        out_printf (dat, FORMAT_HREF11 "", ARGS_HREF11 (hdlptr));             \
       }                                                                       \
       LATER_VERSIONS                                                          \
       {                                                                       \
-        fprintf (dat->fh, FORMAT_HREF "", ARGS_HREF (hdlptr));                \
+        json_write_href (dat, hdlptr);                                        \
       }                                                                       \
     }                                                                         \
   else                                                                        \
     {                                                                         \
-      fprintf (dat->fh, "[0,0,0]");                                           \
+      out_puts (dat, "[0,0,0]");                                              \
     }
-#define VALUE_H(hdl, dxf) fprintf (dat->fh, FORMAT_H "", ARGS_H (hdl))
+#define VALUE_H(hdl, dxf) out_printf (dat, FORMAT_H "", ARGS_H (hdl))
 #define FIELD_HANDLE(nam, handle_code, dxf)                                   \
   {                                                                           \
     if (_obj->nam)                                                            \
       {                                                                       \
         PRE (R_13b1)                                                          \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, JSON_KEY FORMAT_HREF11 "",            \
-                               _path_field (#nam), JSON_SPC,                  \
-                               ARGS_HREF11 (_obj->nam));                      \
+          FIRSTPREFIX out_printf (dat, JSON_KEY FORMAT_HREF11 "",             \
+                                  _path_field (#nam), JSON_SPC,               \
+                                  ARGS_HREF11 (_obj->nam));                   \
         }                                                                     \
         LATER_VERSIONS                                                        \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, JSON_KEY FORMAT_HREF "",              \
-                               _path_field (#nam), JSON_SPC,                  \
-                               ARGS_HREF (_obj->nam));                        \
+          KEY (nam);                                                          \
+          json_write_href (dat, _obj->nam);                                   \
         }                                                                     \
       }                                                                       \
     else                                                                      \
       {                                                                       \
-        FIRSTPREFIX fprintf (dat->fh, JSON_KEY "[0,%s0]", _path_field (#nam), \
-                             JSON_SPC, JSON_SPC);                             \
+        FIRSTPREFIX out_printf (dat, JSON_KEY "[0,%s0]", _path_field (#nam),  \
+                                JSON_SPC, JSON_SPC);                          \
       }                                                                       \
   }
 #define SUB_FIELD_HANDLE(o, nam, handle_code, dxf)                            \
   {                                                                           \
     if (_obj->o.nam)                                                          \
       {                                                                       \
-        FIRSTPREFIX fprintf (dat->fh, JSON_KEY FORMAT_HREF "",                \
-                             _path_field (#nam), JSON_SPC,                    \
-                             ARGS_HREF (_obj->o.nam));                        \
+        KEY (nam);                                                            \
+        json_write_href (dat, _obj->o.nam);                                   \
       }                                                                       \
     else                                                                      \
       {                                                                       \
-        FIRSTPREFIX fprintf (dat->fh, JSON_KEY "[0,%s0]", _path_field (#nam), \
-                             JSON_SPC, JSON_SPC);                             \
+        FIRSTPREFIX out_printf (dat, JSON_KEY "[0,%s0]", _path_field (#nam),  \
+                                JSON_SPC, JSON_SPC);                          \
       }                                                                       \
   }
 #define FIELD_DATAHANDLE(nam, code, dxf) FIELD_HANDLE (nam, code, dxf)
@@ -374,51 +388,51 @@ static char *_path_field (const char *path);
     {                                                                         \
       PRE (R_13b1)                                                            \
       {                                                                       \
-        PREFIX fprintf (dat->fh, FORMAT_HREF11 "", ARGS_HREF11 (_obj->nam));  \
+        PREFIX out_printf (dat, FORMAT_HREF11 "", ARGS_HREF11 (_obj->nam));   \
       }                                                                       \
       LATER_VERSIONS                                                          \
       {                                                                       \
-        PREFIX fprintf (dat->fh, FORMAT_HREF "", ARGS_HREF (_obj->nam));      \
+        PREFIX json_write_href (dat, _obj->nam);                              \
       }                                                                       \
     }                                                                         \
   else                                                                        \
     {                                                                         \
-      PREFIX fprintf (dat->fh, "[0,%s0]", JSON_SPC);                          \
+      PREFIX out_printf (dat, "[0,%s0]", JSON_SPC);                           \
     }
 #define SUB_FIELD_HANDLE_N(o, nam, handle_code, dxf)                          \
   PRINTFIRST;                                                                 \
   if (_obj->o.nam)                                                            \
     {                                                                         \
-      PREFIX fprintf (dat->fh, FORMAT_HREF "", ARGS_HREF (_obj->o.nam));      \
+      PREFIX json_write_href (dat, _obj->o.nam);                              \
     }                                                                         \
   else                                                                        \
     {                                                                         \
-      PREFIX fprintf (dat->fh, "[0,%s0]", JSON_SPC);                          \
+      PREFIX out_printf (dat, "[0,%s0]", JSON_SPC);                           \
     }
 #define VALUE_BINARY(buf, len, dxf)                                           \
   {                                                                           \
-    fprintf (dat->fh, "\"");                                                  \
+    out_puts (dat, "\"");                                                     \
     if (buf && len)                                                           \
       {                                                                       \
         for (long _j = 0; _j < (long)len; _j++)                               \
           {                                                                   \
-            fprintf (dat->fh, "%02X", ((BITCODE_RC *)buf)[_j]);               \
+            out_printf (dat, "%02X", ((BITCODE_RC *)buf)[_j]);                \
           }                                                                   \
       }                                                                       \
-    fprintf (dat->fh, "\"");                                                  \
+    out_puts (dat, "\"");                                                     \
   }
 #define FIELD_BINARY(nam, size, dxf)                                          \
   {                                                                           \
     KEY (nam);                                                                \
-    fprintf (dat->fh, "\"");                                                  \
+    out_puts (dat, "\"");                                                     \
     if (_obj->nam)                                                            \
       {                                                                       \
         for (long _j = 0; _j < (long)size; _j++)                              \
           {                                                                   \
-            fprintf (dat->fh, "%02X", ((BITCODE_RC *)_obj->nam)[_j]);         \
+            out_printf (dat, "%02X", ((BITCODE_RC *)_obj->nam)[_j]);          \
           }                                                                   \
       }                                                                       \
-    fprintf (dat->fh, "\"");                                                  \
+    out_puts (dat, "\"");                                                     \
   }
 
 #define FIELD_B(nam, dxf) FIELD (nam, B, dxf)
@@ -434,8 +448,8 @@ static char *_path_field (const char *path);
     {                                                                         \
       if (!bit_isnan (_obj->nam))                                             \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, JSON_KEY, _path_field (#nam),         \
-                               JSON_SPC);                                     \
+          FIRSTPREFIX out_printf (dat, JSON_KEY, _path_field (#nam),          \
+                                  JSON_SPC);                                  \
           _VALUE_RD (_obj->nam, dxf);                                         \
         }                                                                     \
     }
@@ -443,7 +457,7 @@ static char *_path_field (const char *path);
     {                                                                         \
       if (!bit_isnan (_obj->nam.x) && !bit_isnan (_obj->nam.y))               \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, "\"" #nam "\":%s", JSON_SPC);         \
+          FIRSTPREFIX out_printf (dat, "\"" #nam "\":%s", JSON_SPC);          \
           VALUE_2RD (_obj->nam, dxf);                                         \
         }                                                                     \
     }
@@ -452,7 +466,7 @@ static char *_path_field (const char *path);
       if (!bit_isnan (_obj->nam.x) && !bit_isnan (_obj->nam.y)                \
           && !bit_isnan (_obj->nam.z))                                        \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, "\"" #nam "\":%s", JSON_SPC);         \
+          FIRSTPREFIX out_printf (dat, "\"" #nam "\":%s", JSON_SPC);          \
           VALUE_3RD (_obj->nam, dxf);                                         \
         }                                                                     \
     }
@@ -460,30 +474,30 @@ static char *_path_field (const char *path);
     {                                                                         \
       if (!bit_isnan (_obj->o.nam))                                           \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, JSON_KEY, _path_field (#nam),         \
-                               JSON_SPC);                                     \
+          FIRSTPREFIX out_printf (dat, JSON_KEY, _path_field (#nam),          \
+                                  JSON_SPC);                                  \
           _VALUE_RD (_obj->o.nam, dxf);                                       \
         }                                                                     \
     }
 #else /* IS_RELEASE */
 #  define FIELD_BD(nam, dxf)                                                  \
     {                                                                         \
-      FIRSTPREFIX fprintf (dat->fh, JSON_KEY, _path_field (#nam), JSON_SPC);  \
+      FIRSTPREFIX out_printf (dat, JSON_KEY, _path_field (#nam), JSON_SPC);   \
       _VALUE_RD (_obj->nam, dxf);                                             \
     }
 #  define FIELD_2RD(nam, dxf)                                                 \
     {                                                                         \
-      FIRSTPREFIX fprintf (dat->fh, "\"" #nam "\":%s", JSON_SPC);             \
+      FIRSTPREFIX out_printf (dat, "\"" #nam "\":%s", JSON_SPC);              \
       VALUE_2RD (_obj->nam, dxf);                                             \
     }
 #  define FIELD_3RD(nam, dxf)                                                 \
     {                                                                         \
-      FIRSTPREFIX fprintf (dat->fh, "\"" #nam "\":%s", JSON_SPC);             \
+      FIRSTPREFIX out_printf (dat, "\"" #nam "\":%s", JSON_SPC);              \
       VALUE_3RD (_obj->nam, dxf);                                             \
     }
 #  define SUB_FIELD_BD(o, nam, dxf)                                           \
     {                                                                         \
-      FIRSTPREFIX fprintf (dat->fh, JSON_KEY, _path_field (#nam), JSON_SPC);  \
+      FIRSTPREFIX out_printf (dat, JSON_KEY, _path_field (#nam), JSON_SPC);   \
       _VALUE_RD (_obj->o.nam, dxf);                                           \
     }
 #endif
@@ -612,8 +626,8 @@ field_cmc (Bit_Chain *dat, const char *restrict key,
         {
           FIELD_BS (index, 62);
         }
-      FIRSTPREFIX fprintf (dat->fh, "\"rgb\":%s\"%06x\"", JSON_SPC,
-                           (unsigned)_obj->rgb);
+      FIRSTPREFIX out_printf (dat, "\"rgb\":%s\"%06x\"", JSON_SPC,
+                              (unsigned)_obj->rgb);
       if (_obj->flag)
         {
           FIELD_BS (flag, 0);
@@ -629,8 +643,8 @@ field_cmc (Bit_Chain *dat, const char *restrict key,
     }
   else
     {
-      FIRSTPREFIX fprintf (dat->fh, JSON_KEY FORMAT_RSd, _path_field (key),
-                           JSON_SPC, _obj->index);
+      FIRSTPREFIX out_printf (dat, JSON_KEY FORMAT_RSd, _path_field (key),
+                              JSON_SPC, _obj->index);
     }
 }
 
@@ -638,8 +652,8 @@ field_cmc (Bit_Chain *dat, const char *restrict key,
 #define SUB_FIELD_CMC(o, color, dxf) field_cmc (dat, #color, &_obj->o.color)
 
 #define FIELD_TIMEBLL(nam, dxf)                                               \
-  FIRSTPREFIX fprintf (                                                       \
-      dat->fh, "\"" #nam "\":%s[%s" FORMAT_BL ",%s" FORMAT_BL "%s]",          \
+  FIRSTPREFIX out_printf (                                                    \
+      dat, "\"" #nam "\":%s[%s" FORMAT_BL ",%s" FORMAT_BL "%s]",              \
       JSON_SPC, JSON_SPC, _obj->nam.days, JSON_SPC, _obj->nam.ms, JSON_SPC)
 #define FIELD_TIMERLL(nam, dxf) FIELD_TIMEBLL (nam, dxf)
 
@@ -653,7 +667,7 @@ field_cmc (Bit_Chain *dat, const char *restrict key,
     {                                                                         \
       for (vcount = 0; vcount < (BITCODE_BL)size; vcount++)                   \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, FORMAT_##type, _obj->nam[vcount]);    \
+          FIRSTPREFIX out_printf (dat, FORMAT_##type, _obj->nam[vcount]);     \
         }                                                                     \
     }                                                                         \
   else                                                                        \
@@ -666,7 +680,7 @@ field_cmc (Bit_Chain *dat, const char *restrict key,
     {                                                                         \
       for (vcount = 0; vcount < (BITCODE_BL)size; vcount++)                   \
         {                                                                     \
-          FIRSTPREFIX fprintf (dat->fh, FORMAT_##type, _obj->o.nam[vcount]);  \
+          FIRSTPREFIX out_printf (dat, FORMAT_##type, _obj->o.nam[vcount]);   \
         }                                                                     \
     }                                                                         \
   else                                                                        \
@@ -709,20 +723,20 @@ field_cmc (Bit_Chain *dat, const char *restrict key,
             case 0:                                                           \
               break;                                                          \
             case 1:                                                           \
-              FIRSTPREFIX fprintf (dat->fh, FORMAT_RC,                        \
-                                   (BITCODE_RC)_obj->o.nam[vcount]);          \
+              FIRSTPREFIX out_printf (dat, FORMAT_RC,                         \
+                                      (BITCODE_RC)_obj->o.nam[vcount]);       \
               break;                                                          \
             case 2:                                                           \
-              FIRSTPREFIX fprintf (dat->fh, FORMAT_RS,                        \
-                                   (BITCODE_RS)_obj->o.nam[vcount]);          \
+              FIRSTPREFIX out_printf (dat, FORMAT_RS,                         \
+                                      (BITCODE_RS)_obj->o.nam[vcount]);       \
               break;                                                          \
             case 4:                                                           \
-              FIRSTPREFIX fprintf (dat->fh, FORMAT_RL,                        \
-                                   (BITCODE_RL)_obj->o.nam[vcount]);          \
+              FIRSTPREFIX out_printf (dat, FORMAT_RL,                         \
+                                      (BITCODE_RL)_obj->o.nam[vcount]);       \
               break;                                                          \
             case 8:                                                           \
-              FIRSTPREFIX fprintf (dat->fh, FORMAT_RLL,                       \
-                                   (BITCODE_RLL)_obj->o.nam[vcount]);         \
+              FIRSTPREFIX out_printf (dat, FORMAT_RLL,                        \
+                                      (BITCODE_RLL)_obj->o.nam[vcount]);      \
               break;                                                          \
             default:                                                          \
               LOG_ERROR ("Unknown SUB_FIELD_VECTOR_TYPESIZE " #nam            \
@@ -841,7 +855,7 @@ field_cmc (Bit_Chain *dat, const char *restrict key,
 #define SUBCLASS(name)                                                        \
   SINCE (R_13b1)                                                              \
   {                                                                           \
-    FIRSTPREFIX fprintf (dat->fh, "\"_subclass\":%s\"" #name "\"", JSON_SPC); \
+    FIRSTPREFIX out_printf (dat, "\"_subclass\":%s\"" #name "\"", JSON_SPC);  \
   }
 
 // FIXME: for KEY not the complete nam path, only the field.
@@ -1039,11 +1053,42 @@ _prefix (Bit_Chain *dat)
     {
       for (int _i = 0; _i < dat->bit; _i++)
         {
-          fprintf (dat->fh, "  ");
+          out_write (dat, "  ", 2);
         }
     }
 }
 
+static void
+json_write_key (Bit_Chain *restrict dat, const char *restrict key)
+{
+  out_putc (dat, '"');
+  out_puts (dat, key);
+  out_puts (dat, IS_MINJS ? "\":" : "\": ");
+}
+
+static void
+json_write_string (Bit_Chain *restrict dat, const char *restrict str)
+{
+  out_putc (dat, '"');
+  out_puts (dat, str);
+  out_putc (dat, '"');
+}
+
+// as FORMAT_HREF
+static void
+json_write_href (Bit_Chain *restrict dat, const Dwg_Object_Ref *restrict ref)
+{
+  out_putc (dat, '[');
+  out_uint (dat, ref->handleref.code, 0);
+  out_putc (dat, ',');
+  out_uint (dat, ref->handleref.size, 0);
+  out_putc (dat, ',');
+  out_uint (dat, ref->handleref.value, 0);
+  out_putc (dat, ',');
+  out_uint (dat, ref->absolute_ref, 0);
+  out_putc (dat, ']');
+}
+
 static char *
 _path_field (const char *path)
 {
@@ -1071,7 +1116,7 @@ json_eed (Bit_Chain *restrict dat, const Dwg_Object_Object *restrict obj)
         {
           FIELD (size, RS, 0);
           KEY (handle);
-          fprintf (dat->fh, FORMAT_H, ARGS_H (_obj->handle));
+          out_printf (dat, FORMAT_H, ARGS_H (_obj->handle));
         }
       if (_obj->data)
         {
@@ -1102,7 +1147,7 @@ json_eed (Bit_Chain *restrict dat, const Dwg_Object_Object *restrict obj)
               VALUE_BINARY (data->u.eed_4.data, data->u.eed_4.length, 0);
               break;
             case 5:
-              fprintf (dat->fh, FORMAT_H "", 5, 8, data->u.eed_5.entity);
+              out_printf (dat, FORMAT_H "", 5, 8, data->u.eed_5.entity);
               break;
             case 10:
             case 11:
@@ -1194,8 +1239,8 @@ json_xdata (Bit_Chain *restrict dat, const Dwg_Object_XRECORD *restrict obj)
                      rbuf->type);
           break;
         case DWG_VT_POINT3D:
-          fprintf (dat->fh, "[" FORMAT_RD "," FORMAT_RD "," FORMAT_RD "]",
-                   rbuf->value.pt[0], rbuf->value.pt[1], rbuf->value.pt[2]);
+          out_printf (dat, "[" FORMAT_RD "," FORMAT_RD "," FORMAT_RD "]",
+                      rbuf->value.pt[0], rbuf->value.pt[1], rbuf->value.pt[2]);
           LOG_TRACE ("xdata[%u]: (%f,%f,%f) [3RD %d]\n", i, rbuf->value.pt[0],
                      rbuf->value.pt[1], rbuf->value.pt[2], rbuf->type);
           break;
@@ -1278,10 +1323,10 @@ print_wcquote (Bit_Chain *restrict dat, dwg_wchar_t *restrict wstr)
   uint16_t c;
   if (!ws)
     {
-      fprintf (dat->fh, "\"\"");
+      out_puts (dat, "\"\"");
       return;
     }
-  fprintf (dat->fh, "\"");
+  out_puts (dat, "\"");
   while (1)
     {
 #  ifdef HAVE_ALIGNED_ACCESS_REQUIRED
@@ -1299,58 +1344,58 @@ print_wcquote (Bit_Chain *restrict dat, dwg_wchar_t *restrict wstr)
         break;
       if (c == L'"')
         {
-          fprintf (dat->fh, "\\\"");
+          out_puts (dat, "\\\"");
         }
       else if (c == L'\\' && ws[0] == L'U' && ws[1] == L'+' && ishex (ws[2])
                && ishex (ws[3]) && ishex (ws[4]) && ishex (ws[5]))
         {
-          fprintf (dat->fh, "\\u");
+          out_puts (dat, "\\u");
           ws += 2;
         }
       else if (c == L'\\')
         {
-          fprintf (dat->fh, "\\\\");
+          out_puts (dat, "\\\\");
         }
       else if (c == L'\n')
         {
-          fprintf (dat->fh, "\\n");
+          out_puts (dat, "\\n");
         }
       else if (c == L'\r')
         {
-          fprintf (dat->fh, "\\r");
+          out_puts (dat, "\\r");
         }
       // convert to utf-8
       else if (c < 0x1f || c > 0xff)
         {
           if (c < 0x80)
             {
-              fprintf (dat->fh, "\\u%04x", c);
+              out_printf (dat, "\\u%04x", c);
             }
           else if (c < 0x800)
             {
-              fprintf (dat->fh, "%c%c", (c >> 6) | 0xC0, (c & 0x3F) | 0x80);
+              out_printf (dat, "%c%c", (c >> 6) | 0xC0, (c & 0x3F) | 0x80);
             }
           else /* if (c < 0x10000) */
             {
-              fprintf (dat->fh, "%c%c%c", (c >> 12) | 0xE0,
-                       ((c >> 6) & 0x3F) | 0x80, (c & 0x3F) | 0x80);
+              out_printf (dat, "%c%c%c", (c >> 12) | 0xE0,
+                          ((c >> 6) & 0x3F) | 0x80, (c & 0x3F) | 0x80);
             }
 #  if 0
           // FIXME: handle surrogate pairs properly
           if (c >= 0xd800 && c < 0xdc00)
             {
-              fprintf (dat->fh, "\\u%04x", c - 0x1000);
+              out_printf (dat, "\\u%04x", c - 0x1000);
             }
           else if (c >= 0xdc00 && c < 0xe000)
             ;
           else
-            fprintf (dat->fh, "\\u%04x", c);
+            out_printf (dat, "\\u%04x", c);
 #  endif
         }
       else
-        fprintf (dat->fh, "%c", (char)(c & 0xff));
+        out_printf (dat, "%c", (char)(c & 0xff));
     }
-  fprintf (dat->fh, "\"");
+  out_puts (dat, "\"");
 }
 
 #else
@@ -1416,10 +1461,10 @@ json_write_TFv (Bit_Chain *restrict dat, const BITCODE_TF restrict src,
                 const size_t len)
 {
   const size_t slen = src ? strlen ((char *)src) : 0;
-  fputc ('"', dat->fh);
+  out_putc (dat, '"');
   if (!slen)
     {
-      fputc ('"', dat->fh);
+      out_putc (dat, '"');
       return;
     }
   for (size_t i = 0; i < MIN (slen, len); i++)
@@ -1427,28 +1472,28 @@ json_write_TFv (Bit_Chain *restrict dat, const BITCODE_TF restrict src,
       const unsigned char c = src[i];
       if (c == '\r' || c == '\n' || c == '"' || c == '\\')
         {
-          fputc ('\\', dat->fh);
+          out_putc (dat, '\\');
           if (c == '\r')
-            fputc ('r', dat->fh);
+            out_putc (dat, 'r');
           else if (c == '\n')
-            fputc ('n', dat->fh);
+            out_putc (dat, 'n');
           else
-            fputc (c, dat->fh);
+            out_putc (dat, c);
         }
       else if (c == '\\' && i + 6 < len && src[i] == 'U' && src[i + 1] == '+'
                && ishex (src[i + 2]) && ishex (src[i + 3])
                && ishex (src[i + 4]) && ishex (src[i + 5]))
         {
-          fputc ('\\', dat->fh);
-          fputc ('u', dat->fh);
+          out_putc (dat, '\\');
+          out_putc (dat, 'u');
           i += 3;
         }
       else if (c < 0x1f)
-        fprintf (dat->fh, "\\u00%02x", c);
+        out_printf (dat, "\\u00%02x", c);
       else
-        fputc (c, dat->fh);
+        out_putc (dat, c);
     }
-  fputc ('"', dat->fh);
+  out_putc (dat, '"');
 }
 
 /* Write even past the \0, to keep existing slack.
@@ -1460,10 +1505,10 @@ json_write_TF (Bit_Chain *restrict dat, const BITCODE_TF restrict src,
 {
   const size_t slen = src ? strlen ((char *)src) : 0;
   bool has_slack = false;
-  fputc ('"', dat->fh);
+  out_putc (dat, '"');
   if (!slen)
     {
-      fputc ('"', dat->fh);
+      out_putc (dat, '"');
       return;
     }
   for (size_t i = 0; i < len; i++)
@@ -1471,20 +1516,20 @@ json_write_TF (Bit_Chain *restrict dat, const BITCODE_TF restrict src,
       const unsigned char c = src[i];
       if (c == '\r' || c == '\n' || c == '"' || c == '\\')
         {
-          fputc ('\\', dat->fh);
+          out_putc (dat, '\\');
           if (c == '\r')
-            fputc ('r', dat->fh);
+            out_putc (dat, 'r');
           else if (c == '\n')
-            fputc ('n', dat->fh);
+            out_putc (dat, 'n');
           else
-            fputc (c, dat->fh);
+            out_putc (dat, c);
         }
       else if (c == '\\' && i + 6 < len && src[i] == 'U' && src[i + 1] == '+'
                && ishex (src[i + 2]) && ishex (src[i + 3])
                && ishex (src[i + 4]) && ishex (src[i + 5]))
         {
-          fputc ('\\', dat->fh);
-          fputc ('u', dat->fh);
+          out_putc (dat, '\\');
+          out_putc (dat, 'u');
           i += 3;
         }
       else if (c == '\0')
@@ -1500,19 +1545,19 @@ json_write_TF (Bit_Chain *restrict dat, const BITCODE_TF restrict src,
                   }
             }
           if (has_slack)
-            fprintf (dat->fh, "\\u0000");
+            out_puts (dat, "\\u0000");
           else
             {
-              fputc ('"', dat->fh);
+              out_putc (dat, '"');
               return;
             }
         }
       else if (c < 0x1f)
-        fprintf (dat->fh, "\\u00%02x", c);
+        out_printf (dat, "\\u00%02x", c);
       else
-        fputc (c, dat->fh);
+        out_putc (dat, c);
     }
-  fputc ('"', dat->fh);
+  out_putc (dat, '"');
 }
 
 // also converts from codepage to utf8
@@ -1613,7 +1658,7 @@ json_3dsolid (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
       s = p = (char *)_obj->acis_data;
       if (!p)
         {
-          FIRSTPREFIX fprintf (dat->fh, "\"\"");
+          FIRSTPREFIX out_puts (dat, "\"\"");
         }
       else if (_obj->version < 2)
         { // split lines by \n
@@ -1623,7 +1668,7 @@ json_3dsolid (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
               // and skip the final ^M
               if ((*p == '\r' || *p == '\n') && p - s < 256)
                 {
-                  FIRSTPREFIX fprintf (dat->fh, "\"%.*s\"", (int)(p - s), s);
+                  FIRSTPREFIX out_printf (dat, "\"%.*s\"", (int)(p - s), s);
                   // json_cquote (buf, s, p - s, dat->codepage));
                   if (*p == '\r' && *(p + 1) == '\n')
                     p++;
@@ -1638,7 +1683,7 @@ json_3dsolid (Bit_Chain *restrict dat, const Dwg_Object *restrict obj,
         }
       else // version 2, SAB. split into two lines for easier identification
         {
-          FIRSTPREFIX fprintf (dat->fh, "\"%.*s\"", 15, _obj->acis_data);
+          FIRSTPREFIX out_printf (dat, "\"%.*s\"", 15, _obj->acis_data);
           FIRSTPREFIX VALUE_BINARY (&_obj->acis_data[15], _obj->sab_size - 15,
                                     1);
         }
@@ -1956,7 +2001,7 @@ json_fileheader_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 
   RECORD (FILEHEADER); // single hash
   KEY (version);
-  fprintf (dat->fh, "\"%s\"", dwg_version_codes (dwg->header.version));
+  out_printf (dat, "\"%s\"", dwg_version_codes (dwg->header.version));
   // clang-format off
   #include "header.spec"
   // clang-format on
@@ -2283,21 +2328,32 @@ json_tables_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 }
 
 static int
-json_objects_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
+json_objects_render (Bit_Chain *restrict dat, void *arg,
+                     BITCODE_BL from, BITCODE_BL to)
 {
+  Dwg_Data *dwg = (Dwg_Data *)arg;
   BITCODE_BL i;
+  int error = 0;
 
-  CLEARFIRST;
-  SECTION (OBJECTS);
-  for (i = 0; i < dwg->num_objects; i++)
+  if (from) // not the first run
+    CLEARFIRST;
+  for (i = from; i < to; i++)
     {
-      int error;
       Dwg_Object *obj = &dwg->object[i];
       FIRSTPREFIX HASH;
-      error = dwg_json_object (dat, obj);
+      error |= dwg_json_object (dat, obj);
       ENDHASH
       CLEARFIRST;
     }
+  return error;
+}
+
+static int
+json_objects_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
+{
+  CLEARFIRST;
+  SECTION (OBJECTS);
+  out_render (dat, dwg, dwg->num_objects, json_objects_render, dwg);
   ENDSEC ();
   return 0;
 }
@@ -2315,7 +2371,7 @@ json_handles_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
       Dwg_Object *obj = &dwg->object[j];
       // handle => abs. offset
       // TODO: The real HANDLES section omap has handleoffset (deleted holes) and addressoffset
-      FIRSTPREFIX fprintf (dat->fh, "[%lu,%s%lu]", obj->handle.value, JSON_SPC, obj->address);
+      FIRSTPREFIX out_printf (dat, "[%lu,%s%lu]", obj->handle.value, JSON_SPC, obj->address);
     }
   ENDSEC ();
   return 0;
@@ -2334,8 +2390,8 @@ json_thumbnail_write (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
         _obj->chain += 16; /* skip the sentinel */
       KEY (THUMBNAILIMAGE);
       HASH;
-      FIRSTPREFIX fprintf (dat->fh, "\"size\":%s%" PRIuSIZE, JSON_SPC,
-                           _obj->size);
+      FIRSTPREFIX out_printf (dat, "\"size\":%s%" PRIuSIZE, JSON_SPC,
+                              _obj->size);
       FIELD_BINARY (chain, _obj->size, 310);
       if (dwg->header.from_version >= R_2004)
         _obj->chain -= 16; /* undo for free */
@@ -2462,7 +2518,7 @@ json_section_appinfohistory (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   int error = 0;
 
   RECORD (AppInfoHistory); // single hash
-  FIRSTPREFIX fprintf (dat->fh, "\"size\":%s%d", JSON_SPC, _obj->size);
+  FIRSTPREFIX out_printf (dat, "\"size\":%s%d", JSON_SPC, _obj->size);
   FIELD_BINARY (unknown_bits, _obj->size, 0);
   // clang-format off
   //#include "appinfohistory.spec"
@@ -2627,20 +2683,12 @@ json_section_2ndheader (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   return 0;
 }
 
-EXPORT int
-dwg_write_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
+/* Everything before the OBJECTS */
+static int
+json_write_prologue (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
 {
-  Dwg_Header *obj = &dwg->header;
-  int error = 0;
-
-  if (!dat->version)
-    dat->version = dat->from_version;
-  if (!dat->codepage)
-    dat->codepage = dwg->header.codepage;
-  if (!dat->fh)
-    goto fail;
-  fprintf (dat->fh, "{%s%s%s\"created_by\":%s\"%s\"", JSON_NL, JSON_SPC,
-           JSON_SPC, JSON_SPC, PACKAGE_STRING);
+  out_printf (dat, "{%s%s%s\"created_by\":%s\"%s\"", JSON_NL, JSON_SPC,
+              JSON_SPC, JSON_SPC, PACKAGE_STRING);
   dat->bit++; // ident
 
   json_fileheader_write (dat, dwg);
@@ -2652,21 +2700,25 @@ dwg_write_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   if (dat->version >= R_13b1)
     {
       if (json_classes_write (dat, dwg) >= DWG_ERR_CRITICAL)
-        goto fail;
+        return DWG_ERR_CRITICAL;
     }
   if (dat->version < R_13b1 && 0)
     {
       if (json_tables_write (dat, dwg) >= DWG_ERR_CRITICAL)
-        goto fail;
+        return DWG_ERR_CRITICAL;
     }
+  return 0;
+}
 
-  if (json_objects_write (dat, dwg) >= DWG_ERR_CRITICAL)
-    goto fail;
-
+/* Everything after the OBJECTS */
+static int
+json_write_epilogue (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
+{
+  int error = 0;
   if (dat->version >= R_13b1)
     {
       if (json_thumbnail_write (dat, dwg) >= DWG_ERR_CRITICAL)
-        goto fail;
+        return DWG_ERR_CRITICAL;
       /* the other sections */
       if (dat->version <= R_2000)
         {
@@ -2706,13 +2758,179 @@ dwg_write_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
   if (dat->version >= R_13b1)
     {
       if (json_handles_write (dat, dwg) >= DWG_ERR_CRITICAL)
-        goto fail;
+        return DWG_ERR_CRITICAL;
     }
 #endif
 
   dat->bit--;
-  fprintf (dat->fh, "}%s", JSON_NL);
+  out_printf (dat, "}%s", JSON_NL);
+  // errors in the other sections are not fatal
+  (void)error;
+  return 0;
+}
+
+EXPORT int
+dwg_write_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
+{
+  Out_Buf ob;
+
+  if (!dat->version)
+    dat->version = dat->from_version;
+  if (!dat->codepage)
+    dat->codepage = dwg->header.codepage;
+  if (!dat->fh)
+    return 1;
+  out_buf_begin (dat, &ob);
+  if (json_write_prologue (dat, dwg) >= DWG_ERR_CRITICAL)
+    goto fail;
+  if (json_objects_write (dat, dwg) >= DWG_ERR_CRITICAL)
+    goto fail;
+  if (json_write_epilogue (dat, dwg) >= DWG_ERR_CRITICAL)
+    goto fail;
+  out_buf_end (dat, &ob);
   return 0;
 fail:
+  out_buf_end (dat, &ob);
   return 1;
 }
+
+/* Streaming: the objects are written and the entities freed while
+   decoding */
+
+typedef struct _json_stream
+{
+  Bit_Chain *dat;
+  Out_Buf ob;
+  BITCODE_BL next; /* the first object not yet written */
+  int started;
+  int error;
+} Json_Stream;
+
+/* The SEQEND decoder still validates its owner, and may set
+   POLYLINE.seqend. */
+static int
+json_stream_is_owner (const Dwg_Object *obj)
+{
+  switch (obj->fixedtype)
+    {
+    case DWG_TYPE_INSERT:
+    case DWG_TYPE_MINSERT:
+    case DWG_TYPE_POLYLINE_2D:
+    case DWG_TYPE_POLYLINE_3D:
+    case DWG_TYPE_POLYLINE_PFACE:
+    case DWG_TYPE_POLYLINE_MESH:
+      return 1;
+    default:
+      return 0;
+    }
+}
+
+/* Is the object final already? */
+static int
+json_stream_ready (Dwg_Data *restrict dwg, const Dwg_Object *restrict obj)
+{
+  /* r2013+ SAB data is only added from the AcDs section at the end */
+  if (dwg->header.from_version >= R_2013
+      && obj->supertype == DWG_SUPERTYPE_ENTITY && obj->tio.entity && obj->tio.entity->has_ds_data
+      && dwg_obj_is_3dsolid (obj))
+    return 0;
+  if (obj->fixedtype == DWG_TYPE_POLYLINE_2D
+      || obj->fixedtype == DWG_TYPE_POLYLINE_3D
+      || obj->fixedtype == DWG_TYPE_POLYLINE_PFACE
+      || obj->fixedtype == DWG_TYPE_POLYLINE_MESH)
+    {
+      Dwg_Entity_POLYLINE_2D *_obj;
+      if (!obj->tio.entity || !obj->tio.entity->tio.POLYLINE_2D)
+        return 1;
+      _obj = obj->tio.entity->tio.POLYLINE_2D;
+      if (!_obj->seqend)
+        return 0;
+      return dwg_resolve_handle_silent (dwg, _obj->seqend->absolute_ref)
+             != NULL;
+    }
+  return 1;
+}
+
+/* Writes all complete objects before num. With final all of them. */
+static void
+json_stream_objects (Json_Stream *restrict js, Dwg_Data *restrict dwg,
+                     BITCODE_BL num, int final)
+{
+  Bit_Chain *dat = js->dat;
+  while (js->next < num)
+    {
+      Dwg_Object *obj = &dwg->object[js->next];
+      if (!final && !json_stream_ready (dwg, obj))
+        break;
+      js->error |= json_objects_render (dat, dwg, js->next, js->next + 1);
+      /* Keep the tables, blocks and objects. Only the entities are big
+         and not referenced while decoding. */
+      if (obj->supertype == DWG_SUPERTYPE_ENTITY
+          && !json_stream_is_owner (obj))
+        dwg_free_object (obj);
+      js->next++;
+    }
+}
+
+static void
+json_stream_start (Json_Stream *restrict js, Dwg_Data *restrict dwg)
+{
+  Bit_Chain *dat = js->dat;
+  dat->version = dat->from_version = dwg->header.version;
+  dat->codepage = dwg->header.codepage;
+  out_buf_begin (dat, &js->ob);
+  js->started = 1;
+  js->error |= json_write_prologue (dat, dwg);
+  CLEARFIRST;
+  SECTION (OBJECTS);
+}
+
+static void
+json_stream_hook (Dwg_Data *dwg, BITCODE_BL num, void *arg)
+{
+  Json_Stream *js = (Json_Stream *)arg;
+  if (!js->started)
+    json_stream_start (js, dwg);
+  json_stream_objects (js, dwg, num, 0);
+}
+
+/* Reads the DWG file and writes it as JSON to dat->fh at once, without
+   keeping all objects in memory. Every object is written as soon as it
+   is decoded, and the entities are freed then, with the exception of
+   the INSERT and POLYLINE owners. The output is the same as with
+   dwg_read_file and dwg_write_json. preR13 DWG's are read fully.
+   dwg must be freed by the caller. */
+EXPORT int
+dwg_stream_json (Bit_Chain *restrict dat, const char *restrict filename,
+                 Dwg_Data *restrict dwg)
+{
+  Json_Stream js;
+  int error;
+
+  if (!dat->fh)
+    return 1;
+  memset (&js, 0, sizeof (js));
+  js.dat = dat;
+  dwg->decode_hook = json_stream_hook;
+  dwg->decode_hook_arg = &js;
+  error = dwg_read_file (filename, dwg);
+  dwg->decode_hook = NULL;
+  dwg->decode_hook_arg = NULL;
+  if (!js.started)
+    {
+      // preR13, or no objects at all
+      if (error >= DWG_ERR_CRITICAL)
+        return error;
+      dat->version = dat->from_version = dwg->header.version;
+      dat->codepage = dwg->header.codepage;
+      return dwg_write_json (dat, dwg) ? error | DWG_ERR_IOERROR : error;
+    }
+  // the rest, and close the JSON also on decoding errors
+  json_stream_objects (&js, dwg, dwg->num_objects, 1);
+  ENDSEC ();
+  js.error |= json_write_epilogue (dat, dwg);
+  out_buf_end (dat, &js.ob);
+  if (js.error >= DWG_ERR_CRITICAL)
+    error |= DWG_ERR_IOERROR;
+  return error;
+}
@@ -26,6 +26,10 @@
 #endif
 
 EXPORT int dwg_write_json (Bit_Chain *restrict dat, Dwg_Data *restrict dwg);
+/* dwg_read_file and dwg_write_json in one pass, freeing the entities */
+EXPORT int dwg_stream_json (Bit_Chain *restrict dat,
+                            const char *restrict filename,
+                            Dwg_Data *restrict dwg);
 EXPORT int dwg_write_geojson (Bit_Chain *restrict dat, Dwg_Data *restrict dwg);
 
 // converts a TV to a UTF-8 string (with codepage conversion) and quoting
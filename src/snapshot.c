@@ -0,0 +1,2213 @@
+/*****************************************************************************/
+/*  LibreDWG - free implementation of the DWG file format                    */
+/*                                                                           */
+/*  Copyright (C) 2026 Free Software Foundation, Inc.                        */
+/*                                                                           */
+/*  This library is free software, licensed under the terms of the GNU       */
+/*  General Public License as published by the Free Software Foundation,     */
+/*  either version 3 of the License, or (at your option) any later version.  */
+/*  You should have received a copy of the GNU General Public License        */
+/*  along with this program.  If not, see <http://www.gnu.org/licenses/>.    */
+/*****************************************************************************/
+
+/*
+ * snapshot.c: write and read binary images of a decoded Dwg_Data.
+ *
+ * Walks the specs like free.c, which visits every allocated field once.
+ * The writer stores each struct as raw bytes, and each string, array and
+ * ref block tagged by its address, so shared blocks are stored only once.
+ * The reader allocates and copies them back in the same order.
+ * Pointer fields which the specs do not visit, like parent links, are
+ * found via the dynapi field tables, and translated from the old to the
+ * new addresses at the end.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "common.h"
+#include "bits.h"
+#include "dwg.h"
+#include "decode.h"
+#include "classes.h"
+#include "dynapi.h"
+#include "hash.h"
+#include "snapshot.h"
+
+static unsigned int loglevel;
+#define DWG_LOGLEVEL loglevel
+#include "logging.h"
+
+/* the current version per spec block */
+static unsigned int cur_ver = 0;
+/* the dummy chain for the specs, all snapshot I/O goes to snap.dat */
+static Bit_Chain pdat = { 0 };
+static BITCODE_BL rcount1, rcount2;
+/* for the acis data revisits in free_3dsolid */
+static BITCODE_BL *block_size;
+
+typedef struct _snap_plan
+{
+  uint32_t num;
+  uint32_t *offsets; /* of all pointer fields */
+} Snap_Plan;
+
+typedef struct _snap_range
+{
+  uint64_t old;
+  char *addr;
+  uint64_t len;
+} Snap_Range;
+
+typedef struct _snap_slot
+{
+  void **slot;
+  uint64_t old;
+} Snap_Slot;
+
+typedef struct _snap_ref
+{
+  const Dwg_Object_Ref *ref;
+  uint32_t idx;
+} Snap_Ref;
+
+static struct _snap
+{
+  Bit_Chain *dat; /* the image */
+  Dwg_Data *dwg;
+  int reading;
+  int error;
+  /* writer: block address => id */
+  dwg_inthash *ids;
+  uint32_t num_ids;
+  Snap_Ref *refs; /* sorted global refs */
+  /* reader: id => block address */
+  void **addrs;
+  uint32_t num_addrs, size_addrs;
+  uint64_t old; /* the old address of the next block */
+  uint64_t len; /* the length of the last block */
+  Snap_Range *ranges;
+  uint32_t num_ranges, size_ranges;
+  Snap_Slot *slots; /* pointer fields to translate */
+  size_t num_slots, size_slots;
+  void **allocs; /* all blocks for the dwg, freed on errors */
+  uint32_t num_allocs, size_allocs;
+} snap;
+
+/* Marks untranslated pointer fields. Reads via it see zeros. */
+static double snap_unset_buf[512];
+#define SNAP_UNSET ((void *)snap_unset_buf)
+
+#define SNAP_IS_TU (dat->from_version >= R_2007)
+/* true for inline arrays, which are part of the struct */
+#define SNAP_INLINE(lv) ((const void *)&(lv) == (const void *)(lv))
+#define SNAP_ARRAY(lv, n, type)                                               \
+  (SNAP_INLINE (lv) ? (void)0                                                 \
+                    : snap_array ((void **)&(lv),                             \
+                                  snap.reading ? 0 : (size_t)(n),             \
+                                  sizeof (*(lv)), #type))
+
+/*--------------------------------------------------------------------------------
+ * I/O
+ */
+
+static void
+snap_write (const void *p, size_t n)
+{
+  Bit_Chain *dat = snap.dat;
+  if (dat->byte + n > dat->size)
+    {
+      size_t size = dat->size ? dat->size : 65536;
+      unsigned char *chain;
+      while (dat->byte + n > size)
+        size *= 2;
+      chain = (unsigned char *)realloc (dat->chain, size);
+      if (!chain)
+        {
+          snap.error |= DWG_ERR_OUTOFMEM;
+          return;
+        }
+      dat->chain = chain;
+      dat->size = size;
+    }
+  if (n)
+    memcpy (&dat->chain[dat->byte], p, n);
+  dat->byte += n;
+}
+
+static void
+snap_read (void *p, size_t n)
+{
+  Bit_Chain *dat = snap.dat;
+  if (snap.error >= DWG_ERR_CRITICAL || dat->byte > dat->size
+      || n > dat->size - dat->byte)
+    {
+      if (!(snap.error & DWG_ERR_INVALIDDWG))
+        LOG_ERROR ("Snapshot overflow at %" PRIuSIZE, dat->byte)
+      snap.error |= DWG_ERR_INVALIDDWG;
+      if (n)
+        memset (p, 0, n);
+      return;
+    }
+  if (n)
+    memcpy (p, &dat->chain[dat->byte], n);
+  dat->byte += n;
+}
+
+/* copies n bytes at p to or from the image */
+static void
+snap_raw (void *p, size_t n)
+{
+  if (snap.reading)
+    snap_read (p, n);
+  else
+    snap_write (p, n);
+}
+
+static void *
+snap_grow (void *array, uint32_t *size, size_t elsize)
+{
+  uint32_t newsize = *size ? *size * 2 : 1024;
+  void *p = realloc (array, newsize * elsize);
+  if (!p)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return NULL;
+    }
+  *size = newsize;
+  return p;
+}
+
+/* the reader allocates all memory for the dwg here */
+static void *
+snap_calloc (size_t n, size_t size)
+{
+  void *p;
+  if (snap.num_allocs >= snap.size_allocs)
+    {
+      void **allocs = (void **)snap_grow (snap.allocs, &snap.size_allocs,
+                                          sizeof (void *));
+      if (!allocs)
+        return NULL;
+      snap.allocs = allocs;
+    }
+  p = calloc (n, size);
+  if (!p)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return NULL;
+    }
+  snap.allocs[snap.num_allocs++] = p;
+  return p;
+}
+
+/* the reader knows the new address of an old block */
+static void
+snap_range (uint64_t old, void *addr, uint64_t len)
+{
+  if (!old || !addr)
+    return;
+  if (snap.num_ranges >= snap.size_ranges)
+    {
+      Snap_Range *ranges = (Snap_Range *)snap_grow (
+          snap.ranges, &snap.size_ranges, sizeof (Snap_Range));
+      if (!ranges)
+        return;
+      snap.ranges = ranges;
+    }
+  snap.ranges[snap.num_ranges].old = old;
+  snap.ranges[snap.num_ranges].addr = (char *)addr;
+  snap.ranges[snap.num_ranges].len = len;
+  snap.num_ranges++;
+}
+
+/* the reader got the next tagged block */
+static void
+snap_register (void *addr, uint64_t len)
+{
+  if (snap.num_addrs >= snap.size_addrs)
+    {
+      void **addrs
+          = (void **)snap_grow (snap.addrs, &snap.size_addrs, sizeof (void *));
+      if (!addrs)
+        return;
+      snap.addrs = addrs;
+    }
+  snap.addrs[snap.num_addrs++] = addr;
+  snap_range (snap.old, addr, len);
+}
+
+/* The reader resolves the pointer field later from its old value,
+   unless the spec visits it before. */
+static void
+snap_unset (void **slot)
+{
+  if (!*slot || *slot == SNAP_UNSET)
+    return;
+  if (snap.num_slots >= snap.size_slots)
+    {
+      size_t size = snap.size_slots ? snap.size_slots * 2 : 4096;
+      Snap_Slot *slots
+          = (Snap_Slot *)realloc (snap.slots, size * sizeof (Snap_Slot));
+      if (!slots)
+        {
+          snap.error |= DWG_ERR_OUTOFMEM;
+          return;
+        }
+      snap.slots = slots;
+      snap.size_slots = size;
+    }
+  snap.slots[snap.num_slots].slot = slot;
+  snap.slots[snap.num_slots].old = (uint64_t)(uintptr_t)*slot;
+  snap.num_slots++;
+  *slot = SNAP_UNSET;
+}
+
+static int
+snap_range_cmp (const void *a, const void *b)
+{
+  const Snap_Range *ra = (const Snap_Range *)a;
+  const Snap_Range *rb = (const Snap_Range *)b;
+  return ra->old < rb->old ? -1 : ra->old > rb->old ? 1 : 0;
+}
+
+/* the new address within the last range starting at or before old */
+static void *
+snap_translate (uint64_t old)
+{
+  uint32_t lo = 0, hi = snap.num_ranges;
+  while (lo < hi)
+    {
+      uint32_t mid = lo + (hi - lo) / 2;
+      if (snap.ranges[mid].old <= old)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+  if (lo && old <= snap.ranges[lo - 1].old + snap.ranges[lo - 1].len)
+    return snap.ranges[lo - 1].addr + (old - snap.ranges[lo - 1].old);
+  return NULL;
+}
+
+static void
+snap_relink (void)
+{
+  size_t i, num = 0, lost = 0;
+  /* mostly the specs restored all of them already */
+  for (i = 0; i < snap.num_slots; i++)
+    if (*snap.slots[i].slot == SNAP_UNSET)
+      num++;
+  LOG_TRACE ("snapshot: %" PRIuSIZE " of %" PRIuSIZE
+             " pointers left to relink\n",
+             num, snap.num_slots);
+  if (!num)
+    return;
+  if (snap.num_ranges)
+    qsort (snap.ranges, snap.num_ranges, sizeof (Snap_Range),
+           snap_range_cmp);
+  for (i = 0; i < snap.num_slots; i++)
+    {
+      if (*snap.slots[i].slot != SNAP_UNSET)
+        continue;
+      *snap.slots[i].slot = snap_translate (snap.slots[i].old);
+      if (!*snap.slots[i].slot)
+        lost++;
+    }
+  if (lost)
+    LOG_TRACE ("snapshot: %" PRIuSIZE " dangling pointers set to NULL\n",
+               lost);
+}
+
+/*--------------------------------------------------------------------------------
+ * blocks
+ */
+
+/* Returns 1 if a new block follows. Else *pp is NULL or an earlier block. */
+static int
+snap_tag (void **pp)
+{
+  uint8_t kind;
+  if (!snap.reading)
+    {
+      uint64_t id;
+      if (!*pp)
+        {
+          kind = 0;
+          snap_write (&kind, 1);
+          return 0;
+        }
+      id = hash_get (snap.ids, (uint64_t)(uintptr_t)*pp);
+      if (id != HASH_NOT_FOUND)
+        {
+          uint32_t id32 = (uint32_t)id;
+          kind = 2;
+          snap_write (&kind, 1);
+          snap_write (&id32, 4);
+          return 0;
+        }
+      hash_set (snap.ids, (uint64_t)(uintptr_t)*pp, ++snap.num_ids);
+      kind = 1;
+      snap_write (&kind, 1);
+      snap.old = (uint64_t)(uintptr_t)*pp;
+      snap_write (&snap.old, 8);
+      return 1;
+    }
+  *pp = NULL;
+  snap_read (&kind, 1);
+  if (kind == 1)
+    {
+      snap_read (&snap.old, 8);
+      return 1;
+    }
+  if (kind == 2)
+    {
+      uint32_t id;
+      snap_read (&id, 4);
+      if (id && id <= snap.num_addrs)
+        *pp = snap.addrs[id - 1];
+      else
+        snap.error |= DWG_ERR_INVALIDDWG;
+    }
+  else if (kind)
+    snap.error |= DWG_ERR_INVALIDDWG;
+  return 0;
+}
+
+/* after a new tag: the len bytes at *pp */
+static void *
+snap_block (void **pp, size_t len, size_t minalloc)
+{
+  uint64_t len64 = len;
+  char *p;
+  if (!snap.reading)
+    {
+      snap_write (&len64, 8);
+      snap_write (*pp, len);
+      snap.len = len;
+      return *pp;
+    }
+  snap_read (&len64, 8);
+  if (len64 > snap.dat->size - snap.dat->byte)
+    {
+      snap.error |= DWG_ERR_INVALIDDWG;
+      len64 = 0;
+    }
+  snap.len = len64;
+  /* zero-terminated for strings, non-NULL for empty blocks */
+  p = (char *)snap_calloc ((size_t)(len64 > minalloc ? len64 : minalloc) + 2,
+                          1);
+  if (!p)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return NULL;
+    }
+  snap_read (p, (size_t)len64);
+  snap_register (p, len64);
+  *pp = p;
+  return p;
+}
+
+/* the reader passes 0 as len */
+static void
+snap_binary (void **pp, size_t len)
+{
+  if (snap_tag (pp))
+    snap_block (pp, len, 0);
+}
+
+static void
+snap_string (void **pp, int wide)
+{
+  size_t len = 0;
+  if (!snap.reading && *pp)
+    len = wide ? (bit_wcs2len ((BITCODE_TU)*pp) + 1) * 2
+               : strlen ((char *)*pp) + 1;
+  snap_binary (pp, len);
+}
+
+/*--------------------------------------------------------------------------------
+ * plans: the pointer fields per struct type, from the dynapi
+ */
+
+static dwg_inthash *snap_token_plans;
+static dwg_inthash *snap_elem_plans;
+static Snap_Plan snap_empty_plan;
+
+static void
+snap_plan_add (Snap_Plan *plan, uint32_t offset)
+{
+  uint32_t *offsets = (uint32_t *)realloc (plan->offsets,
+                                           (plan->num + 1) * sizeof (uint32_t));
+  if (!offsets)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return;
+    }
+  plan->offsets = offsets;
+  plan->offsets[plan->num++] = offset;
+}
+
+static int
+snap_is_ptr_type (const char *type, size_t size)
+{
+  static const char *const ptr_types[]
+      = { "H",   "T",    "TV",  "TU",   "TF",  "TFv",
+          "T16", "TU16", "T32", "TU32", "D2T", NULL };
+  const char *const *t;
+  if (strchr (type, '*'))
+    return 1;
+  if (size != sizeof (void *))
+    return 0;
+  for (t = ptr_types; *t; t++)
+    if (strEQ (type, *t))
+      return 1;
+  return 0;
+}
+
+static int
+snap_is_color_type (const char *type)
+{
+  return strEQc (type, "CMC") || strEQc (type, "CMTC")
+         || strEQc (type, "ENC");
+}
+
+static void
+snap_plan_color (Snap_Plan *plan, uint32_t base)
+{
+  snap_plan_add (plan, base + offsetof (Dwg_Color, name));
+  snap_plan_add (plan, base + offsetof (Dwg_Color, book_name));
+  snap_plan_add (plan, base + offsetof (Dwg_Color, handle));
+}
+
+static const Dwg_DYNAPI_field *
+snap_subclass_fields (const char *type)
+{
+  const Dwg_DYNAPI_field *fields;
+  char *name = dwg_dynapi_subclass_name (type);
+  if (!name)
+    return NULL;
+  fields = dwg_dynapi_subclass_fields (name);
+  if (!fields)
+    fields = dwg_dynapi_entity_fields (name);
+  free (name);
+  return fields;
+}
+
+static void
+snap_plan_fields (Snap_Plan *plan, const Dwg_DYNAPI_field *f, uint32_t base,
+                  int depth)
+{
+  for (; f && f->name; f++)
+    {
+      /* unions are handled by the specs */
+      if (memBEGINc (f->name, "lt.") || memBEGINc (f->name, "u.")
+          || memBEGINc (f->name, "value."))
+        continue;
+      if (snap_is_ptr_type (f->type, f->size))
+        snap_plan_add (plan, base + f->offset);
+      else if (snap_is_color_type (f->type))
+        snap_plan_color (plan, base + f->offset);
+      else if (depth < 8
+               && (memBEGINc (f->type, "Dwg_")
+                   || memBEGINc (f->type, "struct _dwg_"))
+               && strNE (f->type, "Dwg_MLEADER_Content"))
+        snap_plan_fields (plan, snap_subclass_fields (f->type),
+                          base + f->offset, depth + 1);
+    }
+}
+
+static const Snap_Plan *
+snap_plan_new (const Dwg_DYNAPI_field *fields)
+{
+  Snap_Plan *plan = (Snap_Plan *)calloc (1, sizeof (Snap_Plan));
+  if (!plan)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return &snap_empty_plan;
+    }
+  snap_plan_fields (plan, fields, 0, 0);
+  return plan;
+}
+
+/* plans live as long as the process, as the names are static */
+static const Snap_Plan *
+snap_plan_cached (dwg_inthash **cachep, const char *key)
+{
+  uint64_t value;
+  if (!*cachep)
+    *cachep = hash_new (256);
+  if (!*cachep)
+    return NULL;
+  value = hash_get (*cachep, (uint64_t)(uintptr_t)key);
+  return value == HASH_NOT_FOUND ? NULL : (const Snap_Plan *)(uintptr_t)value;
+}
+
+/* the plan for a token struct. NULL if unknown to the dynapi */
+static const Snap_Plan *
+snap_plan_token (const char *token)
+{
+  const Snap_Plan *plan = snap_plan_cached (&snap_token_plans, token);
+  const Dwg_DYNAPI_field *fields;
+  if (plan)
+    return plan;
+  fields = dwg_dynapi_entity_fields (*token == '_' ? &token[1] : token);
+  if (!fields || !snap_token_plans)
+    return NULL;
+  plan = snap_plan_new (fields);
+  hash_set (snap_token_plans, (uint64_t)(uintptr_t)token,
+            (uint64_t)(uintptr_t)plan);
+  return plan;
+}
+
+/* the plan for array elements, by the spec type name */
+static const Snap_Plan *
+snap_plan_elem (const char *type, size_t elsize)
+{
+  const Snap_Plan *plan = snap_plan_cached (&snap_elem_plans, type);
+  const char *t = type;
+  Snap_Plan *p;
+  if (plan)
+    return plan;
+  if (!snap_elem_plans)
+    return &snap_empty_plan;
+  p = (Snap_Plan *)calloc (1, sizeof (Snap_Plan));
+  if (!p)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return &snap_empty_plan;
+    }
+  if (memBEGINc (t, "BITCODE_"))
+    t += strlen ("BITCODE_");
+  if (snap_is_ptr_type (t, elsize))
+    snap_plan_add (p, 0);
+  else if (snap_is_color_type (t))
+    snap_plan_color (p, 0);
+  else if (memBEGINc (t, "Dwg_") || memBEGINc (t, "struct _dwg_"))
+    {
+      const Dwg_DYNAPI_field *fields = snap_subclass_fields (t);
+      if (!fields)
+        LOG_WARN ("snapshot: no fields for %s", t)
+      snap_plan_fields (p, fields, 0, 0);
+    }
+  hash_set (snap_elem_plans, (uint64_t)(uintptr_t)type,
+            (uint64_t)(uintptr_t)p);
+  return p;
+}
+
+static void
+snap_plan_apply (const Snap_Plan *plan, void *base)
+{
+  uint32_t i;
+  if (!plan || !base)
+    return;
+  for (i = 0; i < plan->num; i++)
+    snap_unset ((void **)((char *)base + plan->offsets[i]));
+}
+
+/* a tagged array of n elements of type. The reader passes 0 as n */
+static void
+snap_array (void **pp, size_t n, size_t elsize, const char *type)
+{
+  char *p;
+  if (!snap_tag (pp))
+    return;
+  p = (char *)snap_block (pp, n * elsize, 0);
+  if (snap.reading && p && elsize && type)
+    {
+      const Snap_Plan *plan = snap_plan_elem (type, elsize);
+      size_t i;
+      if (plan->num)
+        for (i = 0; i + elsize <= snap.len; i += elsize)
+          snap_plan_apply (plan, p + i);
+    }
+}
+
+/*--------------------------------------------------------------------------------
+ * refs and objects
+ */
+
+static int
+snap_ref_cmp (const void *a, const void *b)
+{
+  const uintptr_t pa = (uintptr_t)((const Snap_Ref *)a)->ref;
+  const uintptr_t pb = (uintptr_t)((const Snap_Ref *)b)->ref;
+  return pa < pb ? -1 : pa > pb ? 1 : 0;
+}
+
+/* index + 1 into dwg->object_ref, or 0 */
+static uint32_t
+snap_global_ref (const Dwg_Object_Ref *ref)
+{
+  Snap_Ref key, *found;
+  if (!snap.refs)
+    return 0;
+  key.ref = ref;
+  found = (Snap_Ref *)bsearch (&key, snap.refs, snap.dwg->num_object_refs,
+                               sizeof (Snap_Ref), snap_ref_cmp);
+  return found ? found->idx + 1 : 0;
+}
+
+/* index + 1 into dwg->object, or 0 */
+static uint32_t
+snap_obj_index (const Dwg_Object *o)
+{
+  const Dwg_Data *dwg = snap.dwg;
+  if (o && dwg->object && o >= dwg->object
+      && o < &dwg->object[dwg->num_objects])
+    return (uint32_t)(o - dwg->object) + 1;
+  return 0;
+}
+
+static Dwg_Object *
+snap_obj_at (uint32_t idx)
+{
+  if (idx && idx <= snap.dwg->num_objects)
+    return &snap.dwg->object[idx - 1];
+  return NULL;
+}
+
+static void
+snap_ref (BITCODE_H *refp)
+{
+  Dwg_Object_Ref *ref = *refp;
+  uint8_t kind;
+  uint32_t idx;
+  if (!snap.reading)
+    {
+      if (!ref)
+        {
+          kind = 0;
+          snap_write (&kind, 1);
+          return;
+        }
+      idx = snap_global_ref (ref);
+      if (idx)
+        {
+          kind = 1;
+          snap_write (&kind, 1);
+          snap_write (&idx, 4);
+          return;
+        }
+      kind = 2;
+      snap_write (&kind, 1);
+      if (snap_tag ((void **)refp))
+        {
+          idx = snap_obj_index (ref->obj);
+          snap_write (ref, sizeof (Dwg_Object_Ref));
+          snap_write (&idx, 4);
+        }
+      return;
+    }
+  *refp = NULL;
+  snap_read (&kind, 1);
+  if (kind == 1)
+    {
+      snap_read (&idx, 4);
+      if (idx && idx <= snap.dwg->num_object_refs && snap.dwg->object_ref)
+        *refp = snap.dwg->object_ref[idx - 1];
+      else
+        snap.error |= DWG_ERR_INVALIDDWG;
+    }
+  else if (kind == 2)
+    {
+      if (snap_tag ((void **)refp))
+        {
+          ref = (Dwg_Object_Ref *)snap_calloc (1, sizeof (Dwg_Object_Ref));
+          if (!ref)
+            {
+              snap.error |= DWG_ERR_OUTOFMEM;
+              return;
+            }
+          snap_read (ref, sizeof (Dwg_Object_Ref));
+          snap_read (&idx, 4);
+          ref->obj = snap_obj_at (idx);
+          snap_register (ref, sizeof (Dwg_Object_Ref));
+          *refp = ref;
+        }
+    }
+  else if (kind)
+    snap.error |= DWG_ERR_INVALIDDWG;
+}
+
+/* Names not owned by the objects, like the static type names, are kept
+   forever. With DWG_OPTS_IN dwg_free would free them. */
+static char **snap_names;
+static uint32_t snap_num_names, snap_size_names;
+
+static const char *
+snap_intern (const char *s)
+{
+  uint32_t i;
+  for (i = 0; i < snap_num_names; i++)
+    if (strEQ (snap_names[i], s))
+      return snap_names[i];
+  if (snap_num_names >= snap_size_names)
+    {
+      char **names = (char **)realloc (
+          snap_names, (snap_size_names + 64) * sizeof (char *));
+      if (!names)
+        return NULL;
+      snap_names = names;
+      snap_size_names += 64;
+    }
+  snap_names[snap_num_names] = strdup (s);
+  return snap_names[snap_num_names++];
+}
+
+/* a static name: u32 len + bytes */
+static void
+snap_static_name (const char **pp)
+{
+  uint32_t len = 0;
+  char *s;
+  if (!snap.reading)
+    {
+      len = (uint32_t)strlen (*pp);
+      snap_write (&len, 4);
+      snap_write (*pp, len);
+      return;
+    }
+  *pp = NULL;
+  snap_read (&len, 4);
+  if (len > snap.dat->size - snap.dat->byte)
+    {
+      snap.error |= DWG_ERR_INVALIDDWG;
+      return;
+    }
+  s = (char *)malloc (len + 1);
+  if (!s)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return;
+    }
+  snap_read (s, len);
+  s[len] = '\0';
+  *pp = snap_intern (s);
+  free (s);
+}
+
+/* obj->name and obj->dxfname */
+static void
+snap_obj_name (Dwg_Object *restrict obj, char **pp, int is_dxfname)
+{
+  uint8_t kind = 0;
+  if (!snap.reading)
+    {
+      const char *s = *pp;
+      if (!s)
+        kind = 0;
+      else if (obj->klass && obj->klass->dxfname
+               && strEQ (s, obj->klass->dxfname))
+        kind = 1;
+      else if (is_dxfname && obj->name && strEQ (s, obj->name))
+        kind = 2;
+      else if (dwg_type_name (obj->fixedtype)
+               && strEQ (s, dwg_type_name (obj->fixedtype)))
+        kind = 4;
+      else
+        kind = 3;
+      snap_write (&kind, 1);
+      if (kind == 3)
+        snap_static_name ((const char **)pp);
+      return;
+    }
+  *pp = NULL;
+  snap_read (&kind, 1);
+  switch (kind)
+    {
+    case 0:
+      break;
+    case 1:
+      *pp = obj->klass ? obj->klass->dxfname : NULL;
+      break;
+    case 2:
+      *pp = obj->name;
+      break;
+    case 3:
+      snap_static_name ((const char **)pp);
+      break;
+    case 4:
+      *pp = (char *)dwg_type_name (obj->fixedtype);
+      break;
+    default:
+      snap.error |= DWG_ERR_INVALIDDWG;
+    }
+}
+
+/* The common and token structs of obj, raw. Returns 0 for none,
+   1 for the common struct only, 2 for both. */
+static int
+snap_tio (Dwg_Object *restrict obj, size_t size, const char *token,
+          int is_entity)
+{
+  const size_t common_size
+      = is_entity ? sizeof (Dwg_Object_Entity) : sizeof (Dwg_Object_Object);
+  const Snap_Plan *plan = token ? snap_plan_token (token) : NULL;
+  uint8_t kind = 0;
+  void *common, **tokenp;
+  uint64_t old;
+
+  if (!snap.reading)
+    {
+      if (size && obj->tio.object)
+        {
+          kind = 1;
+          tokenp = is_entity ? (void **)&obj->tio.entity->tio.LINE
+                             : (void **)&obj->tio.object->tio.APPID;
+          if (*tokenp && plan)
+            kind = 2;
+          else if (*tokenp)
+            {
+              LOG_ERROR ("snapshot: %s unsupported, no dynapi fields",
+                         token);
+              snap.error |= DWG_ERR_NOTYETSUPPORTED;
+            }
+        }
+      else if (obj->tio.object)
+        {
+          LOG_WARN ("snapshot: skipped %s [%u]", obj->name ? obj->name : "",
+                    obj->index);
+        }
+      snap_write (&kind, 1);
+      if (kind)
+        snap_write (obj->tio.object, common_size);
+      if (kind > 1)
+        snap_write (is_entity ? (void *)obj->tio.entity->tio.LINE
+                              : (void *)obj->tio.object->tio.APPID,
+                    size);
+      return kind;
+    }
+
+  snap_read (&kind, 1);
+  old = (uint64_t)(uintptr_t)obj->tio.object;
+  obj->tio.object = NULL;
+  if (!kind || snap.error >= DWG_ERR_CRITICAL)
+    return 0;
+  if (kind > 2 || (kind == 2 && !plan))
+    {
+      snap.error |= DWG_ERR_INVALIDDWG;
+      return 0;
+    }
+  common = snap_calloc (1, common_size);
+  if (!common)
+    {
+      snap.error |= DWG_ERR_OUTOFMEM;
+      return 0;
+    }
+  snap_read (common, common_size);
+  snap_range (old, common, common_size);
+  obj->tio.object = (Dwg_Object_Object *)common;
+  snap_plan_apply (
+      snap_plan_cached (&snap_token_plans,
+                        is_entity ? "Dwg_Object_Entity" : "Dwg_Object_Object"),
+      common);
+  tokenp = is_entity ? (void **)&obj->tio.entity->tio.LINE
+                     : (void **)&obj->tio.object->tio.APPID;
+  old = (uint64_t)(uintptr_t)*tokenp;
+  *tokenp = NULL;
+  if (kind > 1)
+    {
+      void *t = snap_calloc (1, size);
+      if (!t)
+        {
+          snap.error |= DWG_ERR_OUTOFMEM;
+          return 1;
+        }
+      snap_read (t, size);
+      snap_range (old, t, size);
+      snap_plan_apply (plan, t);
+      /* all token structs start with the parent */
+      *(void **)t = common;
+      *tokenp = t;
+    }
+  if (is_entity)
+    obj->tio.entity->dwg = snap.dwg;
+  else
+    obj->tio.object->dwg = snap.dwg;
+  return kind;
+}
+
+static size_t
+snap_eed_data_size (const Dwg_Eed_Data *data)
+{
+  switch (data->code)
+    {
+    case 0:
+      if (data->u.eed_0.is_tu)
+        return offsetof (Dwg_Eed_Data, u.eed_0_r2007.string)
+               + (data->u.eed_0_r2007.length + 1) * 2;
+      return offsetof (Dwg_Eed_Data, u.eed_0.string)
+             + data->u.eed_0.length + 1;
+    case 1:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_1);
+    case 2:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_2);
+    case 3:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_3);
+    case 4:
+      return offsetof (Dwg_Eed_Data, u.eed_4.data) + data->u.eed_4.length;
+    case 5:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_5);
+    case 10:
+    case 11:
+    case 12:
+    case 13:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_10);
+    case 40:
+    case 41:
+    case 42:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_40);
+    case 70:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_70);
+    case 71:
+      return offsetof (Dwg_Eed_Data, u) + sizeof (data->u.eed_71);
+    default:
+      return 1;
+    }
+}
+
+static void
+snap_eed (Dwg_Object *obj, int is_entity)
+{
+  BITCODE_BL i, num_eed;
+  Dwg_Eed **eedp;
+  if (!obj->tio.object)
+    return;
+  if (is_entity)
+    {
+      num_eed = obj->tio.entity->num_eed;
+      eedp = &obj->tio.entity->eed;
+    }
+  else
+    {
+      num_eed = obj->tio.object->num_eed;
+      eedp = &obj->tio.object->eed;
+    }
+  snap_array ((void **)eedp, num_eed, sizeof (Dwg_Eed), NULL);
+  if (!*eedp)
+    return;
+  for (i = 0; i < num_eed; i++)
+    {
+      Dwg_Eed *eed = &(*eedp)[i];
+      snap_binary ((void **)&eed->raw, snap.reading ? 0 : eed->size);
+      if (snap_tag ((void **)&eed->data))
+        snap_block ((void **)&eed->data,
+                    snap.reading ? 0 : snap_eed_data_size (eed->data),
+                    sizeof (Dwg_Eed_Data) + 8);
+    }
+}
+
+/* XRECORD xdata: a linked list of result buffers */
+static void
+snap_xdata (Dwg_Resbuf **rbp)
+{
+  uint8_t more;
+  if (!snap.reading)
+    {
+      Dwg_Resbuf *rb;
+      for (rb = *rbp; rb; rb = rb->nextrb)
+        {
+          more = 1;
+          snap_write (&more, 1);
+          snap_write (rb, sizeof (Dwg_Resbuf));
+          switch (dwg_resbuf_value_type (rb->type))
+            {
+            case DWG_VT_STRING:
+              snap_binary ((void **)&rb->value.str.u.data,
+                           rb->value.str.is_tu
+                               ? ((size_t)rb->value.str.size + 1) * 2
+                               : (size_t)rb->value.str.size + 1);
+              break;
+            case DWG_VT_BINARY:
+              snap_binary ((void **)&rb->value.str.u.data,
+                           rb->value.str.size);
+              break;
+            default:
+              break;
+            }
+        }
+      more = 0;
+      snap_write (&more, 1);
+      return;
+    }
+  *rbp = NULL;
+  snap_read (&more, 1);
+  while (more == 1 && snap.error < DWG_ERR_CRITICAL)
+    {
+      Dwg_Resbuf *rb = (Dwg_Resbuf *)snap_calloc (1, sizeof (Dwg_Resbuf));
+      if (!rb)
+        {
+          snap.error |= DWG_ERR_OUTOFMEM;
+          return;
+        }
+      snap_read (rb, sizeof (Dwg_Resbuf));
+      rb->nextrb = NULL;
+      switch (dwg_resbuf_value_type (rb->type))
+        {
+        case DWG_VT_STRING:
+        case DWG_VT_BINARY:
+          snap_binary ((void **)&rb->value.str.u.data, 0);
+          break;
+        default:
+          break;
+        }
+      *rbp = rb;
+      rbp = &rb->nextrb;
+      snap_read (&more, 1);
+    }
+}
+
+/*--------------------------------------------------------------------------------
+ * MACROS
+ */
+
+#define ACTION snapshot
+#define IS_FREE
+
+#undef UNTIL
+#undef SINCE
+#undef PRE
+#undef VERSIONS
+#undef VERSION
+#define UNTIL(v) if (dat->from_version <= v)
+#define SINCE(v) if (dat->from_version >= v)
+#define PRE(v) if (dat->from_version < v)
+#define VERSIONS(v1, v2)                                                      \
+  if (dat->from_version >= v1 && dat->from_version <= v2)
+#define VERSION(v) if (dat->from_version == v)
+
+#define VALUE(value, type, dxf)
+#define VALUE_RC(value, dxf) VALUE (value, RC, dxf)
+#define VALUE_RS(value, dxf) VALUE (value, RS, dxf)
+#define VALUE_RL(value, dxf) VALUE (value, RL, dxf)
+#define VALUE_RLx(value, dxf) VALUE (value, RL, dxf)
+#define VALUE_RD(value, dxf) VALUE (value, RD, dxf)
+#define VALUE_BD(value, dxf) VALUE (value, BD, dxf)
+
+#define FIELD(name, type)                                                     \
+  {                                                                           \
+  }
+#define FIELD_TRACE(name, type)                                               \
+  LOG_TRACE (#name ": " FORMAT_##type "\n", _obj->name)
+#define FIELD_G_TRACE(name, type, dxfgroup)                                   \
+  LOG_TRACE (#name ": " FORMAT_##type " [" #type " %d]\n", _obj->name,        \
+             dxfgroup)
+#define FIELD_CAST(name, type, cast, dxf)                                     \
+  {                                                                           \
+  }
+#define SUB_FIELD_CAST(o, name, type, cast, dxf)                              \
+  {                                                                           \
+  }
+#define SUB_FIELD(o, nam, type, dxf) FIELD (_obj->o.nam, type)
+
+#define ANYCODE -1
+#define FIELD_HANDLE(nam, code, dxf) VALUE_HANDLE (_obj->nam, nam, code, dxf)
+#define SUB_FIELD_HANDLE(o, nam, code, dxf)                                   \
+  VALUE_HANDLE (_obj->o.nam, nam, code, dxf)
+#define VALUE_HANDLE(ref, nam, _code, dxf)                                    \
+  {                                                                           \
+    snap_ref (&(ref));                                                        \
+  }
+#define FIELD_DATAHANDLE(name, code, dxf) FIELD_HANDLE (name, code, dxf)
+#define FIELD_HANDLE_N(name, vcount, code, dxf) FIELD_HANDLE (name, code, dxf)
+#define FIELD_VECTOR_INL(nam, type, size, dxf)
+#define VALUE_H(hdl, dxf)
+
+#define FIELD_B(name, dxf) FIELD (name, B)
+#define FIELD_BB(name, dxf) FIELD (name, BB)
+#define FIELD_3B(name, dxf) FIELD (name, 3B)
+#define FIELD_BS(name, dxf) FIELD (name, BS)
+#define FIELD_BL(name, dxf) FIELD (name, BL)
+#define FIELD_BLL(name, dxf) FIELD (name, BLL)
+#define FIELD_BD(name, dxf) FIELD (name, BD)
+#define FIELD_RC(name, dxf) FIELD (name, RC)
+#define FIELD_RS(name, dxf) FIELD (name, RS)
+#define FIELD_RD(name, dxf) FIELD (name, RD)
+#define FIELD_RL(name, dxf) FIELD (name, RL)
+#define FIELD_RLL(name, dxf) FIELD (name, RLL)
+#define FIELD_MC(name, dxf) FIELD (name, MC)
+#define FIELD_MS(name, dxf) FIELD (name, MS)
+#define FIELD_TV(name, dxf)                                                   \
+  {                                                                           \
+    snap_string ((void **)&_obj->name, 0);                                    \
+  }
+#define VALUE_TF(value, dxf)                                                  \
+  {                                                                           \
+  }
+#define VALUE_TV(value, dxf)                                                  \
+  {                                                                           \
+  }
+#define VALUE_TFF(value, dxf)
+#define FIELD_TU(name, dxf)                                                   \
+  {                                                                           \
+    snap_string ((void **)&_obj->name, 1);                                    \
+  }
+#define FIELD_TF(name, len, dxf)                                              \
+  {                                                                           \
+    snap_binary ((void **)&_obj->name, snap.reading ? 0 : (size_t)(len));     \
+  }
+#define FIELD_TFv(name, len, dxf) FIELD_TF (name, len, dxf)
+#define FIELD_TFF(name, len, dxf)                                             \
+  {                                                                           \
+  }
+#define FIELD_T(name, dxf)                                                    \
+  {                                                                           \
+    snap_string ((void **)&_obj->name, SNAP_IS_TU);                           \
+  }
+#define FIELD_BINARY(name, len, dxf) FIELD_TF (name, len, dxf)
+#define FIELD_T16(name, dxf) FIELD_T (name, dxf)
+#define FIELD_TU16(name, dxf) FIELD_TU (name, dxf)
+#define FIELD_T32(name, dxf) FIELD_T (name, dxf)
+#define FIELD_TU32(name, dxf) FIELD_T (name, dxf)
+#define FIELD_BT(name, dxf) FIELD (name, BT);
+#define FIELD_4BITS(name, dxf)                                                \
+  {                                                                           \
+  }
+#define FIELD_BE(name, dxf)                                                   \
+  {                                                                           \
+  }
+#define FIELD_DD(name, _default, dxf)                                         \
+  {                                                                           \
+  }
+#define FIELD_2DD(name, def, dxf)                                             \
+  {                                                                           \
+  }
+#define FIELD_3DD(name, def, dxf)                                             \
+  {                                                                           \
+  }
+#define FIELD_2RD(name, dxf)                                                  \
+  {                                                                           \
+  }
+#define FIELD_2BD(name, dxf)                                                  \
+  {                                                                           \
+  }
+#define FIELD_2BD_1(name, dxf)                                                \
+  {                                                                           \
+  }
+#define FIELD_3RD(name, dxf)                                                  \
+  {                                                                           \
+  }
+#define FIELD_3BD(name, dxf)                                                  \
+  {                                                                           \
+  }
+#define FIELD_3BD_1(name, dxf)                                                \
+  {                                                                           \
+  }
+#define FIELD_3DPOINT(name, dxf)                                              \
+  {                                                                           \
+  }
+#define FIELD_2PT_TRACE(name, type, dxf)                                      \
+  {                                                                           \
+  }
+#define FIELD_3PT_TRACE(name, type, dxf)                                      \
+  {                                                                           \
+  }
+#define FIELD_TIMEBLL(name, dxf)
+#define FIELD_TIMERLL(name, dxf)
+#define FIELD_CMC(color, dxf)                                                 \
+  {                                                                           \
+    FIELD_T (color.name, 0);                                                  \
+    FIELD_T (color.book_name, 0);                                             \
+    FIELD_HANDLE (color.handle, 0, 0);                                        \
+  }
+#define SUB_FIELD_CMC(o, color, dxf) FIELD_CMC (o.color, dxf)
+
+// FIELD_VECTOR_N(name, type, size):
+// stores the array, and then visits each element.
+#define FIELD_VECTOR_N(nam, type, size, dxf)                                  \
+  {                                                                           \
+    SNAP_ARRAY (_obj->nam, size, type);                                       \
+    if (_obj->nam)                                                            \
+      for (vcount = 0; vcount < (BITCODE_BL)(size); vcount++)                 \
+        FIELD_##type (nam[vcount], dxf);                                      \
+  }
+#define FIELD_VECTOR_T(name, type, size, dxf)                                 \
+  FIELD_VECTOR_N (name, type, _obj->size, dxf)
+#define FIELD_VECTOR(name, type, size, dxf)                                   \
+  FIELD_VECTOR_N (name, type, _obj->size, dxf)
+#define FIELD_2RD_VECTOR(name, size, dxf)                                     \
+  {                                                                           \
+    SNAP_ARRAY (_obj->name, _obj->size, 2RD);                                 \
+  }
+#define FIELD_2DD_VECTOR(name, size, dxf) FIELD_2RD_VECTOR (name, size, dxf)
+#define FIELD_3DPOINT_VECTOR(name, size, dxf)                                 \
+  {                                                                           \
+    SNAP_ARRAY (_obj->name, _obj->size, 3BD);                                 \
+  }
+#define HANDLE_VECTOR_N(name, size, code, dxf)                                \
+  {                                                                           \
+    SNAP_ARRAY (_obj->name, size, H);                                         \
+    if (_obj->name)                                                           \
+      for (vcount = 0; vcount < (BITCODE_BL)(size); vcount++)                 \
+        FIELD_HANDLE_N (name[vcount], vcount, code, dxf);                     \
+  }
+#define HANDLE_VECTOR(name, sizefield, code, dxf)                             \
+  HANDLE_VECTOR_N (name, FIELD_VALUE (sizefield), code, dxf)
+#define SUB_HANDLE_VECTOR(o, name, sizefield, code, dxf)                      \
+  {                                                                           \
+    SNAP_ARRAY (_obj->o.name, _obj->o.sizefield, H);                          \
+    if (_obj->o.name)                                                         \
+      for (vcount = 0; vcount < (BITCODE_BL)_obj->o.sizefield; vcount++)      \
+        SUB_FIELD_HANDLE (o, name[vcount], code, dxf);                        \
+  }
+#define SUB_FIELD_VECTOR_N(o, nam, type, size, dxf)                           \
+  {                                                                           \
+    SNAP_ARRAY (_obj->o.nam, size, type);                                     \
+    if (_obj->o.nam)                                                          \
+      for (vcount = 0; vcount < (BITCODE_BL)(size); vcount++)                 \
+        SUB_FIELD_##type (o, nam[vcount], dxf);                               \
+  }
+#define SUB_FIELD_VECTOR(o, nam, type, sizefield, dxf)                        \
+  SUB_FIELD_VECTOR_N (o, nam, type, _obj->o.sizefield, dxf)
+#define SUB_FIELD_2RD_VECTOR(o, name, size, dxf)                              \
+  {                                                                           \
+    SNAP_ARRAY (_obj->o.name, _obj->o.size, 2RD);                             \
+  }
+#define SUB_FIELD_3BD_VECTOR(o, name, size, dxf)                              \
+  {                                                                           \
+    SNAP_ARRAY (_obj->o.name, _obj->o.size, 3BD);                             \
+  }
+#define SUB_FIELD_VECTOR_TYPESIZE(o, nam, size, typesize, dxf)                \
+  {                                                                           \
+    snap_binary ((void **)&_obj->o.nam,                                       \
+                 snap.reading ? 0 : (size_t)_obj->o.size * (typesize));       \
+  }
+
+#define FIELD_NUM_INSERTS(num_inserts, type, dxf)
+#define FIELD_XDATA(name, size)                                               \
+  {                                                                           \
+    snap_xdata (&_obj->name);                                                 \
+  }
+
+#define REACTORS(code)                                                        \
+  {                                                                           \
+    SNAP_ARRAY (obj->tio.object->reactors, obj->tio.object->num_reactors,    \
+                H);                                                           \
+    if (obj->tio.object->reactors)                                            \
+      for (vcount = 0; vcount < obj->tio.object->num_reactors; vcount++)      \
+        VALUE_HANDLE (obj->tio.object->reactors[vcount], reactors, code,      \
+                      330);                                                   \
+  }
+#define ENT_REACTORS(code)                                                    \
+  {                                                                           \
+    SNAP_ARRAY (_ent->reactors, _ent->num_reactors, H);                       \
+    if (_ent->reactors)                                                       \
+      for (vcount = 0; vcount < _ent->num_reactors; vcount++)                 \
+        VALUE_HANDLE (_ent->reactors[vcount], reactors, code, 330);           \
+  }
+#define XDICOBJHANDLE(code)                                                   \
+  VALUE_HANDLE (obj->tio.object->xdicobjhandle, xdicobjhandle, code, 0)
+#define ENT_XDICOBJHANDLE(code)                                               \
+  VALUE_HANDLE (_ent->xdicobjhandle, xdicobjhandle, code, 0)
+
+/* the arrays are stored with the first REPEAT */
+#define REPEAT_CN(times, name, type) _REPEAT_CN (times, name, type, 1)
+#define REPEAT_N(times, name, type) _REPEAT_CN (times, name, type, 1)
+#define _REPEAT_CN(times, name, type, idx)                                    \
+  if ((SNAP_ARRAY (_obj->name, times, type), _obj->name != NULL))             \
+    for (rcount##idx = 0; rcount##idx < (BITCODE_BL)(times); rcount##idx++)
+#define _REPEAT_CNF(times, name, type, idx) _REPEAT_CN (times, name, type, idx)
+#define _REPEAT_NF(times, name, type, idx) _REPEAT_CN (times, name, type, idx)
+#define _REPEAT(times, name, type, idx)                                       \
+  _REPEAT_CN (_obj->times, name, type, idx)
+#define _REPEAT_C(times, name, type, idx) _REPEAT (times, name, type, idx)
+#define REPEAT(times, name, type) _REPEAT (times, name, type, 1)
+#define REPEAT2(times, name, type) _REPEAT (times, name, type, 2)
+#define REPEAT3(times, name, type) _REPEAT (times, name, type, 3)
+#define REPEAT4(times, name, type) _REPEAT (times, name, type, 4)
+#define REPEAT_C(times, name, type) _REPEAT_C (times, name, type, 1)
+#define REPEAT2_C(times, name, type) _REPEAT_C (times, name, type, 2)
+#define REPEAT3_C(times, name, type) _REPEAT_C (times, name, type, 3)
+#define REPEAT4_C(times, name, type) _REPEAT_C (times, name, type, 4)
+#define END_REPEAT(field)
+
+/* the acis data of 3DSOLID, REGION, BODY */
+#define SUBCLASS(text)                                                        \
+  {                                                                           \
+    if (strEQc (#text, "AcDbModelerGeometry"))                                \
+      snap_3dsolid (obj, (Dwg_Entity_3DSOLID *)_obj);                         \
+  }
+/* done by snap_3dsolid */
+#define FREE_IF(ptr)                                                          \
+  {                                                                           \
+  }
+
+#define COMMON_ENTITY_HANDLE_DATA
+#define SECTION_STRING_STREAM
+#define START_STRING_STREAM
+#define END_STRING_STREAM
+#define START_HANDLE_STREAM
+
+#include "spec.h"
+
+#undef SET_PARENT
+#undef SET_PARENT_OBJ
+#undef SET_PARENT_FIELD
+#define SET_PARENT(field, to)                                                 \
+  if (snap.reading)                                                           \
+  _obj->field.parent = to
+#define SET_PARENT_OBJ(field) SET_PARENT (field, _obj)
+#define SET_PARENT_FIELD(field, what_parent, to)                              \
+  if (snap.reading)                                                           \
+  _obj->field.what_parent = to
+
+static void
+snap_3dsolid (Dwg_Object *restrict obj, Dwg_Entity_3DSOLID *restrict _obj)
+{
+  size_t acis_size = 0;
+  BITCODE_BL i;
+  if (!_obj)
+    return;
+  if (!_obj->acis_empty)
+    {
+      if (_obj->version == 1)
+        {
+          SNAP_ARRAY (_obj->block_size, _obj->num_blocks + 1, BL);
+          SNAP_ARRAY (_obj->encr_sat_data, _obj->num_blocks + 1, char *);
+          if (_obj->encr_sat_data)
+            for (i = 0; i <= _obj->num_blocks; i++)
+              snap_binary ((void **)&_obj->encr_sat_data[i],
+                           snap.reading || !_obj->block_size
+                               ? 0
+                               : _obj->block_size[i]);
+          if (!snap.reading && _obj->block_size)
+            for (i = 0; i < _obj->num_blocks; i++)
+              acis_size += _obj->block_size[i];
+          acis_size++;
+        }
+      else
+        {
+          SNAP_ARRAY (_obj->block_size, 2, BL);
+          acis_size = _obj->sab_size;
+        }
+    }
+  else
+    acis_size = _obj->sab_size;
+  snap_binary ((void **)&_obj->acis_data, snap.reading ? 0 : acis_size);
+  block_size = _obj->block_size;
+}
+
+#define DWG_ENTITY(token)                                                     \
+  static int dwg_snapshot_##token##_private (                                 \
+      Bit_Chain *dat, Bit_Chain *hdl_dat, Bit_Chain *str_dat,                 \
+      Dwg_Object *restrict obj);                                              \
+                                                                              \
+  static int dwg_snapshot_##token (Bit_Chain *restrict dat,                   \
+                                   Dwg_Object *restrict obj)                  \
+  {                                                                           \
+    int error = 0;                                                            \
+    int kind = snap_tio (obj, sizeof (Dwg_Entity_##token), #token, 1);        \
+    if (kind > 1)                                                             \
+      error = dwg_snapshot_##token##_private (dat, dat, dat, obj);            \
+    if (kind)                                                                 \
+      {                                                                       \
+        dwg_snapshot_common_entity_data (dat, obj);                           \
+        snap_eed (obj, 1);                                                    \
+      }                                                                       \
+    return error;                                                             \
+  }                                                                           \
+  static int dwg_snapshot_##token##_private (                                 \
+      Bit_Chain *dat, Bit_Chain *hdl_dat, Bit_Chain *str_dat,                 \
+      Dwg_Object *restrict obj)                                               \
+  {                                                                           \
+    BITCODE_BL vcount, rcount3, rcount4;                                      \
+    Dwg_Entity_##token *ent, *_obj;                                           \
+    Dwg_Object_Entity *_ent;                                                  \
+    Dwg_Data *dwg = obj->parent;                                              \
+    int error = 0;                                                            \
+    _ent = obj->tio.entity;                                                   \
+    if (!_ent)                                                                \
+      return 0;                                                               \
+    _obj = ent = _ent->tio.token;
+
+#define DWG_ENTITY_END                                                        \
+  return error;                                                               \
+  }
+
+#define DWG_OBJECT(token)                                                     \
+  static int dwg_snapshot_##token##_private (                                 \
+      Bit_Chain *dat, Bit_Chain *hdl_dat, Bit_Chain *str_dat,                 \
+      Dwg_Object *restrict obj);                                              \
+                                                                              \
+  static int dwg_snapshot_##token (Bit_Chain *restrict dat,                   \
+                                   Dwg_Object *restrict obj)                  \
+  {                                                                           \
+    int error = 0;                                                            \
+    int kind = snap_tio (obj, sizeof (Dwg_Object_##token), #token, 0);        \
+    if (kind > 1)                                                             \
+      error = dwg_snapshot_##token##_private (dat, dat, dat, obj);            \
+    if (kind)                                                                 \
+      {                                                                       \
+        dwg_snapshot_common_object_data (dat, obj);                           \
+        snap_eed (obj, 0);                                                    \
+      }                                                                       \
+    return error;                                                             \
+  }                                                                           \
+                                                                              \
+  static int dwg_snapshot_##token##_private (                                 \
+      Bit_Chain *dat, Bit_Chain *hdl_dat, Bit_Chain *str_dat,                 \
+      Dwg_Object *restrict obj)                                               \
+  {                                                                           \
+    BITCODE_BL vcount, rcount3, rcount4;                                      \
+    Dwg_Object_##token *_obj;                                                 \
+    Dwg_Data *dwg = obj->parent;                                              \
+    int error = 0;                                                            \
+    if (!obj->tio.object)                                                     \
+      return 0;                                                               \
+    _obj = obj->tio.object->tio.token;
+
+#define DWG_OBJECT_END                                                        \
+  return error;                                                               \
+  }
+
+static void
+dwg_snapshot_common_entity_data (Bit_Chain *dat, Dwg_Object *obj)
+{
+  Dwg_Data *dwg = obj->parent;
+  Bit_Chain *hdl_dat = dat;
+  Dwg_Object_Entity *_obj;
+  Dwg_Object_Entity *_ent;
+  BITCODE_BL vcount;
+  int error = 0;
+
+  _ent = obj->tio.entity;
+  if (!_ent)
+    return;
+  _obj = _ent;
+
+  snap_binary ((void **)&_ent->preview,
+               snap.reading ? 0 : (size_t)_ent->preview_size);
+
+  // clang-format off
+  #include "common_entity_data.spec"
+  if (dat->from_version >= R_2007 && _ent->color.flag & 0x40)
+    FIELD_HANDLE (color.handle, 0, 430);
+  SINCE (R_13b1) {
+    #include "common_entity_handle_data.spec"
+  }
+  // clang-format on
+}
+
+static void
+dwg_snapshot_common_object_data (Bit_Chain *dat, Dwg_Object *obj)
+{
+  Dwg_Data *dwg = obj->parent;
+  Bit_Chain *hdl_dat = dat;
+  Dwg_Object_Object *_obj = obj->tio.object;
+  BITCODE_BL vcount;
+  int error = 0;
+
+  // clang-format off
+  #include "common_object_handle_data.spec"
+  // clang-format on
+}
+
+#include "dwg.spec"
+
+// see free_TABLESTYLE_r2010
+static void
+snap_TABLESTYLE_r2010 (Bit_Chain *restrict dat, Dwg_Object *restrict obj)
+{
+  Dwg_Object_TABLESTYLE *_obj
+      = obj->tio.object ? obj->tio.object->tio.TABLESTYLE : NULL;
+  BITCODE_BL vcount;
+  if (!_obj)
+    return;
+  SNAP_ARRAY (_obj->rowstyles, 3, Dwg_TABLESTYLE_rowstyles);
+  if (_obj->rowstyles)
+    for (unsigned i = 0; i < 3; i++)
+      {
+        SNAP_ARRAY (_obj->rowstyles[i].borders, 6, Dwg_TABLESTYLE_border);
+        if (_obj->rowstyles[i].borders)
+          for (unsigned j = 0; j < 6; j++)
+            {
+              SUB_FIELD_CMTC (rowstyles[i].borders[j], color, 0);
+            }
+        SUB_FIELD_HANDLE (rowstyles[i], text_style, 5, 7);
+        SUB_FIELD_CMTC (rowstyles[i], text_color, 0);
+        SUB_FIELD_CMTC (rowstyles[i], fill_color, 0);
+      }
+  SNAP_ARRAY (_obj->sty.cellstyle.borders, _obj->sty.cellstyle.num_borders,
+              Dwg_BorderStyle);
+  if (_obj->sty.cellstyle.borders)
+    for (unsigned j = 0; j < _obj->sty.cellstyle.num_borders; j++)
+      {
+        SUB_FIELD_HANDLE (sty.cellstyle.borders[j], ltype, 3, 340);
+        SUB_FIELD_CMTC (sty.cellstyle.borders[j], color, 0);
+      }
+  FIELD_CMTC (sty.cellstyle.bg_color, 62);
+  FIELD_T (sty.cellstyle.content_format.value_format_string, 300);
+  if (_obj->numoverrides)
+    {
+      SNAP_ARRAY (_obj->ovr.cellstyle.borders,
+                  _obj->ovr.cellstyle.num_borders, Dwg_BorderStyle);
+      if (_obj->ovr.cellstyle.borders)
+        for (unsigned j = 0; j < _obj->ovr.cellstyle.num_borders; j++)
+          {
+            SUB_FIELD_HANDLE (ovr.cellstyle.borders[j], ltype, 3, 340);
+            SUB_FIELD_CMTC (ovr.cellstyle.borders[j], color, 0);
+          }
+      FIELD_CMTC (ovr.cellstyle.bg_color, 62);
+      FIELD_T (ovr.cellstyle.content_format.value_format_string, 300);
+    }
+  FIELD_TV (name, 3);
+  FIELD_TV (sty.name, 300);
+  FIELD_TV (ovr.name, 300);
+}
+
+static int
+snap_object (Bit_Chain *restrict dat, Dwg_Object *restrict obj)
+{
+  Dwg_Data *dwg = snap.dwg;
+  uint32_t klass = 0;
+  int error = 0;
+
+  if (!snap.reading && obj->klass && dwg->dwg_class
+      && obj->klass >= dwg->dwg_class
+      && obj->klass < &dwg->dwg_class[dwg->num_classes])
+    klass = (uint32_t)(obj->klass - dwg->dwg_class) + 1;
+  snap_raw (&klass, 4);
+  if (snap.reading)
+    {
+      obj->parent = dwg;
+      obj->klass = klass && klass <= dwg->num_classes
+                       ? &dwg->dwg_class[klass - 1]
+                       : NULL;
+    }
+  snap_obj_name (obj, &obj->name, 0);
+  snap_obj_name (obj, &obj->dxfname, 1);
+  snap_binary ((void **)&obj->unknown_bits,
+               snap.reading ? 0 : (obj->num_unknown_bits + 7) / 8);
+  snap_binary ((void **)&obj->unknown_rest,
+               snap.reading ? 0 : (obj->num_unknown_rest + 7) / 8);
+  snap_binary ((void **)&obj->raw, snap.reading ? 0 : obj->size);
+  if (obj->type == DWG_TYPE_FREED)
+    return snap_tio (obj, 0, NULL, 0);
+
+#undef DWG_ENTITY
+#undef DWG_OBJECT
+#define SNAP_TYPE(name)                                                       \
+  case DWG_TYPE_##name:                                                       \
+    error = dwg_snapshot_##name (dat, obj);                                   \
+    break;
+#define DWG_ENTITY(name) SNAP_TYPE (name)
+#define DWG_OBJECT(name) SNAP_TYPE (name)
+
+  switch (obj->fixedtype)
+    {
+#include "objects.inc"
+
+    default:
+      snap_tio (obj, 0, NULL, obj->supertype == DWG_SUPERTYPE_ENTITY);
+      return DWG_ERR_UNHANDLEDCLASS;
+    }
+
+#undef DWG_ENTITY
+#undef DWG_OBJECT
+#undef SNAP_TYPE
+
+  if (obj->fixedtype == DWG_TYPE_TABLESTYLE
+      && dwg->header.from_version > R_2007)
+    snap_TABLESTYLE_r2010 (dat, obj);
+  return error;
+}
+
+/*--------------------------------------------------------------------------------
+ * sections
+ */
+
+static void
+snap_header_vars (Dwg_Data *dwg)
+{
+  Dwg_Header_Variables *_obj = &dwg->header_vars;
+  Dwg_Object *obj = NULL;
+  Bit_Chain *dat = &pdat;
+
+  if (snap.reading)
+    snap_plan_apply (
+        snap_plan_cached (&snap_token_plans, "Dwg_Header_Variables"), _obj);
+  // clang-format off
+  #include "header_variables.spec"
+  // clang-format on
+
+  FIELD_TV (DWGCODEPAGE, 0);
+}
+
+static void
+snap_summaryinfo (Dwg_Data *dwg)
+{
+  Dwg_SummaryInfo *_obj = &dwg->summaryinfo;
+  Dwg_Object *obj = NULL;
+  Bit_Chain *dat = &pdat;
+
+  // clang-format off
+  #include "summaryinfo.spec"
+  // clang-format on
+}
+
+static void
+snap_appinfo (Dwg_Data *dwg)
+{
+  Dwg_AppInfo *_obj = &dwg->appinfo;
+  Dwg_Object *obj = NULL;
+  Bit_Chain *dat = &pdat;
+
+  // clang-format off
+  #include "appinfo.spec"
+  // clang-format on
+}
+
+static void
+snap_filedeplist (Dwg_Data *dwg)
+{
+  Dwg_FileDepList *_obj = &dwg->filedeplist;
+  Dwg_Object *obj = NULL;
+  Bit_Chain *dat = &pdat;
+  BITCODE_RL vcount;
+
+  // clang-format off
+  #include "filedeplist.spec"
+  // clang-format on
+}
+
+static void
+snap_security (Dwg_Data *dwg)
+{
+  Dwg_Security *_obj = &dwg->security;
+  Dwg_Object *obj = NULL;
+  Bit_Chain *dat = &pdat;
+
+  // clang-format off
+  #include "security.spec"
+  // clang-format on
+}
+
+static int
+snap_acds (Dwg_Data *dwg)
+{
+  Dwg_AcDs *_obj = &dwg->acds;
+  Dwg_Object *obj = NULL;
+  Bit_Chain *dat = &pdat;
+  BITCODE_RL rcount3 = 0, rcount4, vcount;
+  int error = 0;
+
+  if (snap.reading)
+    snap_plan_apply (snap_plan_cached (&snap_token_plans, "Dwg_AcDs"), _obj);
+  // clang-format off
+  #include "acds.spec"
+  // clang-format on
+  return error;
+}
+
+/* the pointers in the raw Dwg_Data outside of the objects */
+static void
+snap_unset_sections (Dwg_Data *dwg)
+{
+  unsigned i;
+  void **slots[] = {
+    (void **)&dwg->summaryinfo.TITLE,
+    (void **)&dwg->summaryinfo.SUBJECT,
+    (void **)&dwg->summaryinfo.AUTHOR,
+    (void **)&dwg->summaryinfo.KEYWORDS,
+    (void **)&dwg->summaryinfo.COMMENTS,
+    (void **)&dwg->summaryinfo.LASTSAVEDBY,
+    (void **)&dwg->summaryinfo.REVISIONNUMBER,
+    (void **)&dwg->summaryinfo.HYPERLINKBASE,
+    (void **)&dwg->summaryinfo.props,
+    (void **)&dwg->appinfo.appinfo_name,
+    (void **)&dwg->appinfo.version,
+    (void **)&dwg->appinfo.comment,
+    (void **)&dwg->appinfo.product_info,
+    (void **)&dwg->filedeplist.features,
+    (void **)&dwg->filedeplist.files,
+    (void **)&dwg->security.crypto_name,
+    (void **)&dwg->security.encr_buffer,
+    (void **)&dwg->mspace_block,
+    (void **)&dwg->pspace_block,
+  };
+  for (i = 0; i < ARRAY_SIZE (slots); i++)
+    snap_unset (slots[i]);
+}
+
+static void
+snap_header_sections (Dwg_Data *dwg)
+{
+  Dwg_Header *hdr = &dwg->header;
+  BITCODE_BL i, j, num;
+  const BITCODE_BL num_sections
+      = hdr->from_version < R_2004 ? hdr->num_sections + 2 : hdr->num_sections;
+
+  SNAP_ARRAY (hdr->section, num_sections, Dwg_Section);
+  SNAP_ARRAY (hdr->section_info, hdr->section_infohdr.num_desc,
+              Dwg_Section_Info);
+  if (!hdr->section_info)
+    return;
+  /* sections[] point into header.section */
+  for (i = 0; i < hdr->section_infohdr.num_desc; i++)
+    {
+      Dwg_Section_Info *info = &hdr->section_info[i];
+      num = info->num_sections;
+      if (snap.reading)
+        info->sections = NULL;
+      if (snap_tag ((void **)&info->sections))
+        {
+          uint32_t *idx = (uint32_t *)calloc (num + 1, sizeof (uint32_t));
+          if (!idx)
+            {
+              snap.error |= DWG_ERR_OUTOFMEM;
+              return;
+            }
+          if (!snap.reading)
+            for (j = 0; j < num; j++)
+              {
+                Dwg_Section *s = info->sections[j];
+                if (s && hdr->section && s >= hdr->section
+                    && s < &hdr->section[num_sections])
+                  idx[j] = (uint32_t)(s - hdr->section) + 1;
+              }
+          snap_raw (idx, num * sizeof (uint32_t));
+          if (snap.reading)
+            {
+              info->sections = (Dwg_Section **)snap_calloc (
+                  num + 1, sizeof (Dwg_Section *));
+              if (!info->sections)
+                snap.error |= DWG_ERR_OUTOFMEM;
+              else
+                for (j = 0; j < num; j++)
+                  if (idx[j] && idx[j] <= num_sections && hdr->section)
+                    info->sections[j] = &hdr->section[idx[j] - 1];
+              snap_register (info->sections, num * sizeof (Dwg_Section *));
+            }
+          free (idx);
+        }
+    }
+}
+
+static void
+snap_misc (Dwg_Data *dwg)
+{
+  Bit_Chain *dat = &pdat;
+  unsigned i;
+  size_t size = dwg->thumbnail.size;
+
+  /* the section with its sentinels, see decode_preview */
+  if (dwg->header.from_version >= R_2007a
+      && dwg->header.from_version <= R_2007)
+    size += 32;
+  else if (dwg->header.from_version >= R_2004)
+    size += 16;
+  snap_binary ((void **)&dwg->thumbnail.chain,
+               snap.reading || !dwg->thumbnail.chain ? 0 : size);
+  snap_binary ((void **)&dwg->vbaproject.unknown_bits,
+               snap.reading ? 0 : dwg->vbaproject.size);
+  snap_binary ((void **)&dwg->appinfohistory.unknown_bits,
+               snap.reading ? 0 : dwg->appinfohistory.size);
+  SNAP_ARRAY (dwg->revhistory.histories, dwg->revhistory.num_histories, RL);
+  snap_string ((void **)&dwg->Template.description, SNAP_IS_TU);
+  snap_ref (&dwg->auxheader.R11_HANDSEED);
+  SNAP_ARRAY (dwg->acis_sab_hdl, dwg->num_acis_sab_hdl, H);
+  if (dwg->acis_sab_hdl)
+    for (i = 0; i < dwg->num_acis_sab_hdl; i++)
+      snap_ref (&dwg->acis_sab_hdl[i]);
+  for (i = 0; i < ARRAY_SIZE (dwg->secondheader.handles); i++)
+    {
+      uint8_t has_name = dwg->secondheader.handles[i].name != NULL;
+      snap_raw (&has_name, 1);
+      if (has_name)
+        snap_static_name (&dwg->secondheader.handles[i].name);
+      else
+        dwg->secondheader.handles[i].name = NULL;
+    }
+}
+
+/* the global refs, object_ref[] */
+static void
+snap_object_refs (Dwg_Data *dwg)
+{
+  BITCODE_BL i;
+  if (snap.reading)
+    {
+      const BITCODE_BL size
+          = ((dwg->num_object_refs / REFS_PER_REALLOC) + 1) * REFS_PER_REALLOC;
+      dwg->object_ref = NULL;
+      if (!dwg->num_object_refs)
+        return;
+      dwg->object_ref
+          = (Dwg_Object_Ref **)snap_calloc (size, sizeof (Dwg_Object_Ref *));
+      if (!dwg->object_ref)
+        {
+          snap.error |= DWG_ERR_OUTOFMEM;
+          return;
+        }
+    }
+  for (i = 0; i < dwg->num_object_refs && snap.error < DWG_ERR_CRITICAL;
+       i++)
+    {
+      Dwg_Object_Ref *ref = dwg->object_ref ? dwg->object_ref[i] : NULL;
+      uint8_t present = ref != NULL;
+      uint64_t old = (uint64_t)(uintptr_t)ref;
+      uint32_t idx = 0;
+      snap_raw (&present, 1);
+      if (!present)
+        continue;
+      if (!snap.reading)
+        {
+          idx = snap_obj_index (ref->obj);
+          snap_write (&old, 8);
+          snap_write (ref, sizeof (Dwg_Object_Ref));
+          snap_write (&idx, 4);
+          continue;
+        }
+      ref = (Dwg_Object_Ref *)snap_calloc (1, sizeof (Dwg_Object_Ref));
+      if (!ref)
+        {
+          snap.error |= DWG_ERR_OUTOFMEM;
+          return;
+        }
+      snap_read (&old, 8);
+      snap_read (ref, sizeof (Dwg_Object_Ref));
+      snap_read (&idx, 4);
+      ref->obj = snap_obj_at (idx);
+      snap_range (old, ref, sizeof (Dwg_Object_Ref));
+      dwg->object_ref[i] = ref;
+    }
+}
+
+static void
+snap_object_map (Dwg_Data *dwg)
+{
+  uint8_t present = dwg->object_map != NULL;
+  dwg_inthash *map;
+  snap_raw (&present, 1);
+  if (!snap.reading)
+    {
+      if (present)
+        {
+          snap_write (dwg->object_map, sizeof (dwg_inthash));
+          snap_write (dwg->object_map->array,
+                      dwg->object_map->size * sizeof (struct _hashbucket));
+        }
+      return;
+    }
+  dwg->object_map = NULL;
+  if (!present)
+    return;
+  map = (dwg_inthash *)snap_calloc (1, sizeof (dwg_inthash));
+  if (!map)
+    return;
+  snap_read (map, sizeof (dwg_inthash));
+  map->array = NULL;
+  if (!map->size
+      || map->size > (snap.dat->size - snap.dat->byte)
+                         / sizeof (struct _hashbucket))
+    {
+      snap.error |= DWG_ERR_INVALIDDWG;
+      return;
+    }
+  map->array = (struct _hashbucket *)snap_calloc (
+      map->size, sizeof (struct _hashbucket));
+  if (!map->array)
+    return;
+  snap_read (map->array, (size_t)map->size * sizeof (struct _hashbucket));
+  dwg->object_map = map;
+}
+
+static void
+snap_classes (Dwg_Data *dwg)
+{
+  BITCODE_BS i;
+  SNAP_ARRAY (dwg->dwg_class, dwg->num_classes, Dwg_Class);
+  if (!dwg->dwg_class)
+    return;
+  for (i = 0; i < dwg->num_classes; i++)
+    {
+      Dwg_Class *klass = &dwg->dwg_class[i];
+      const int is_tu = dwg->header.from_version >= R_2007;
+      snap_string ((void **)&klass->appname, is_tu);
+      snap_string ((void **)&klass->cppname, is_tu);
+      snap_string ((void **)&klass->dxfname, 0);
+      if (is_tu)
+        snap_string ((void **)&klass->dxfname_u, 1);
+      else if (snap.reading)
+        snap_unset ((void **)&klass->dxfname_u);
+    }
+}
+
+/* the preamble identifies the library version and ABI */
+static int
+snap_preamble (Dwg_Data *dwg)
+{
+  char magic[8];
+  uint32_t values[6];
+  const uint32_t expect[6] = { DWG_SNAPSHOT_FORMAT,
+                               0x01020304,
+                               (uint32_t)sizeof (void *),
+                               (uint32_t)sizeof (Dwg_Data),
+                               (uint32_t)sizeof (Dwg_Object),
+                               (uint32_t)sizeof (Dwg_Object_Entity) };
+  const char *version = PACKAGE_VERSION;
+  const char *image_version = version;
+  if (!snap.reading)
+    {
+      snap_write (DWG_SNAPSHOT_MAGIC, 8);
+      snap_write (expect, sizeof (expect));
+      snap_static_name (&image_version);
+      return 0;
+    }
+  snap_read (magic, 8);
+  snap_read (values, sizeof (values));
+  if (memcmp (magic, DWG_SNAPSHOT_MAGIC, 8)
+      || memcmp (values, expect, sizeof (values)))
+    {
+      LOG_ERROR ("Incompatible snapshot format or ABI")
+      return DWG_ERR_INVALIDDWG;
+    }
+  snap_static_name (&image_version);
+  if (!image_version || strNE (image_version, version))
+    {
+      LOG_ERROR ("Snapshot of libredwg %s, not %s",
+                 image_version ? image_version : "", version)
+      return DWG_ERR_INVALIDDWG;
+    }
+  return 0;
+}
+
+static void
+snap_begin (Bit_Chain *restrict dat, Dwg_Data *restrict dwg, int reading)
+{
+  memset (&snap, 0, sizeof (snap));
+  snap.dat = dat;
+  snap.dwg = dwg;
+  snap.reading = reading;
+  loglevel = dwg->opts & DWG_OPTS_LOGLEVEL;
+  /* the common and header plans, by the names used in snap_tio */
+  if (!snap_plan_cached (&snap_token_plans, "Dwg_Object_Entity")
+      && snap_token_plans)
+    {
+      hash_set (snap_token_plans, (uint64_t)(uintptr_t) "Dwg_Object_Entity",
+                (uint64_t)(uintptr_t)snap_plan_new (
+                    dwg_dynapi_common_entity_fields ()));
+      hash_set (snap_token_plans, (uint64_t)(uintptr_t) "Dwg_Object_Object",
+                (uint64_t)(uintptr_t)snap_plan_new (
+                    dwg_dynapi_common_object_fields ()));
+      hash_set (snap_token_plans,
+                (uint64_t)(uintptr_t) "Dwg_Header_Variables",
+                (uint64_t)(uintptr_t)snap_plan_new (
+                    dwg_dynapi_header_fields ()));
+      hash_set (snap_token_plans, (uint64_t)(uintptr_t) "Dwg_AcDs",
+                (uint64_t)(uintptr_t)snap_plan_new (
+                    dwg_dynapi_subclass_fields ("AcDs")));
+    }
+}
+
+static void
+snap_end (void)
+{
+  if (snap.ids)
+    hash_free (snap.ids);
+  free (snap.refs);
+  free (snap.addrs);
+  free (snap.ranges);
+  free (snap.slots);
+  free (snap.allocs);
+  memset (&snap, 0, sizeof (snap));
+}
+
+int
+dwg_is_snapshot (const Bit_Chain *dat)
+{
+  return dat->chain && dat->size >= 8
+         && !memcmp (dat->chain, DWG_SNAPSHOT_MAGIC, 8);
+}
+
+int
+dwg_encode_snapshot (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
+{
+  BITCODE_BL i;
+  uint64_t old = (uint64_t)(uintptr_t)dwg;
+  int error;
+
+  if (dwg->header.from_version < R_13b1 || dwg->opts & DWG_OPTS_IN)
+    {
+      LOG_ERROR ("Snapshots of preR13 or imported drawings are not supported")
+      return DWG_ERR_NOTYETSUPPORTED;
+    }
+  snap_begin (dat, dwg, 0);
+  LOG_INFO ("\n============\ndwg_encode_snapshot\n")
+  snap.ids = hash_new (dwg->num_objects * 8 + 1024);
+  if (!snap.ids)
+    return DWG_ERR_OUTOFMEM;
+  if (dwg->num_object_refs && dwg->object_ref)
+    {
+      snap.refs = (Snap_Ref *)calloc (dwg->num_object_refs, sizeof (Snap_Ref));
+      if (!snap.refs)
+        {
+          snap_end ();
+          return DWG_ERR_OUTOFMEM;
+        }
+      for (i = 0; i < dwg->num_object_refs; i++)
+        {
+          snap.refs[i].ref = dwg->object_ref[i];
+          snap.refs[i].idx = i;
+        }
+      qsort (snap.refs, dwg->num_object_refs, sizeof (Snap_Ref),
+             snap_ref_cmp);
+    }
+  pdat.version = dwg->header.version;
+  pdat.from_version = dwg->header.from_version;
+  pdat.opts = dwg->opts;
+
+  snap_preamble (dwg);
+  snap_write (&old, 8);
+  snap_write (dwg, sizeof (Dwg_Data));
+  snap_classes (dwg);
+  snap_write (dwg->object, dwg->num_objects * sizeof (Dwg_Object));
+  snap_object_refs (dwg);
+  snap_object_map (dwg);
+  for (i = 0; i < dwg->num_objects && snap.error < DWG_ERR_CRITICAL; i++)
+    snap_object (&pdat, &dwg->object[i]);
+  snap_header_vars (dwg);
+  snap_summaryinfo (dwg);
+  snap_appinfo (dwg);
+  snap_filedeplist (dwg);
+  snap_security (dwg);
+  snap_acds (dwg);
+  snap_header_sections (dwg);
+  snap_misc (dwg);
+
+  LOG_TRACE ("snapshot: %u blocks, %" PRIuSIZE " bytes\n", snap.num_ids,
+             dat->byte)
+  error = snap.error;
+  snap_end ();
+  return error;
+}
+
+int
+dwg_decode_snapshot (Bit_Chain *restrict dat, Dwg_Data *restrict dwg)
+{
+  const unsigned int opts = dwg->opts;
+  const Dwg_Decode_Hook decode_hook = dwg->decode_hook;
+  void *const decode_hook_arg = dwg->decode_hook_arg;
+  Dwg_Object *object;
+  uint64_t old;
+  BITCODE_BL i;
+  int error;
+
+  snap_begin (dat, dwg, 1);
+  LOG_INFO ("\n============\ndwg_decode_snapshot\n")
+  error = snap_preamble (dwg);
+  if (error)
+    {
+      snap_end ();
+      return error;
+    }
+  snap_read (&old, 8);
+  snap_read (dwg, sizeof (Dwg_Data));
+  dwg->opts = opts;
+  dwg->decode_hook = decode_hook;
+  dwg->decode_hook_arg = decode_hook_arg;
+  if (snap.error || dwg->header.from_version < R_13b1
+      || dwg->header.from_version >= R_AFTER)
+    {
+      memset (dwg, 0, sizeof (Dwg_Data));
+      dwg->opts = opts;
+      snap_end ();
+      return DWG_ERR_INVALIDDWG;
+    }
+  snap_range (old, dwg, sizeof (Dwg_Data));
+  pdat.version = dwg->header.version;
+  pdat.from_version = dwg->header.from_version;
+  pdat.opts = opts;
+  dat->version = dwg->header.version;
+  dat->from_version = dwg->header.from_version;
+  /* never shared with the old process */
+  dwg->object_ordered_ref = NULL;
+  dwg->num_object_ordered_refs = 0;
+  dwg->class_map = NULL;
+  dwg->num_class_map = 0;
+  dwg->dirty_refs = 0;
+  dwg->arena = NULL; // restored onto the heap
+
+  snap_classes (dwg);
+  old = (uint64_t)(uintptr_t)dwg->object;
+  dwg->object = NULL;
+  dwg->num_alloced_objects = dwg->num_objects;
+  if (dwg->num_objects)
+    {
+      if (dwg->num_objects
+          > (dat->size - dat->byte) / sizeof (Dwg_Object))
+        snap.error |= DWG_ERR_INVALIDDWG;
+      else
+        {
+          object = (Dwg_Object *)snap_calloc (dwg->num_objects,
+                                              sizeof (Dwg_Object));
+          if (!object)
+            snap.error |= DWG_ERR_OUTOFMEM;
+          else
+            {
+              snap_read (object, dwg->num_objects * sizeof (Dwg_Object));
+              snap_range (old, object,
+                          dwg->num_objects * sizeof (Dwg_Object));
+              dwg->object = object;
+            }
+        }
+    }
+  if (!dwg->object)
+    dwg->num_objects = dwg->num_alloced_objects = 0;
+  snap_object_refs (dwg);
+  snap_object_map (dwg);
+  for (i = 0; i < dwg->num_objects && snap.error < DWG_ERR_CRITICAL; i++)
+    snap_object (&pdat, &dwg->object[i]);
+  /* the rest still points into the old process */
+  if (snap.error >= DWG_ERR_CRITICAL)
+    goto fail;
+  snap_header_vars (dwg);
+  snap_unset_sections (dwg);
+  snap_summaryinfo (dwg);
+  snap_appinfo (dwg);
+  snap_filedeplist (dwg);
+  snap_security (dwg);
+  snap_acds (dwg);
+  snap_header_sections (dwg);
+  snap_misc (dwg);
+  if (snap.error >= DWG_ERR_CRITICAL)
+    goto fail;
+  snap_relink ();
+
+  /* a copy of the first BLOCK_CONTROL object, as in the decoder */
+  if (dwg->block_control.parent)
+    {
+      memset (&dwg->block_control, 0, sizeof (dwg->block_control));
+      for (i = 0; i < dwg->num_objects; i++)
+        if (dwg->object[i].fixedtype == DWG_TYPE_BLOCK_CONTROL
+            && dwg->object[i].tio.object
+            && dwg->object[i].tio.object->tio.BLOCK_CONTROL)
+          {
+            dwg->block_control
+                = *dwg->object[i].tio.object->tio.BLOCK_CONTROL;
+            break;
+          }
+    }
+
+  LOG_TRACE ("snapshot: %u blocks restored\n", snap.num_addrs)
+  error = snap.error;
+  snap_end ();
+  return error;
+
+fail:
+  LOG_ERROR ("Invalid snapshot at %" PRIuSIZE, dat->byte)
+  error = snap.error;
+  for (i = 0; i < snap.num_allocs; i++)
+    free (snap.allocs[i]);
+  memset (dwg, 0, sizeof (Dwg_Data));
+  dwg->opts = opts;
+  snap_end ();
+  return error;
+}
+
+#undef IS_FREE
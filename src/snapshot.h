@@ -0,0 +1,44 @@
+/*****************************************************************************/
+/*  LibreDWG - free implementation of the DWG file format                    */
+/*                                                                           */
+/*  Copyright (C) 2026 Free Software Foundation, Inc.                        */
+/*                                                                           */
+/*  This library is free software, licensed under the terms of the GNU       */
+/*  General Public License as published by the Free Software Foundation,     */
+/*  either version 3 of the License, or (at your option) any later version.  */
+/*  You should have received a copy of the GNU General Public License        */
+/*  along with this program.  If not, see <http://www.gnu.org/licenses/>.    */
+/*****************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/*
+ * snapshot.h: binary images of a decoded Dwg_Data.
+ *             Written once after a slow decode, and read back with plain
+ *             copies of all structs, strings and arrays, without any bit
+ *             decoding. The image is tied to the library version and the
+ *             host ABI (pointer size, endianness, struct sizes), and is
+ *             rejected otherwise.
+ *             A snapshot is a trusted cache: truncated images are rejected,
+ *             but the struct contents are not validated again.
+ */
+
+#include "config.h"
+#include "common.h"
+#include "bits.h"
+#include "dwg.h"
+
+#define DWG_SNAPSHOT_MAGIC "LDWGSNAP"
+/* bump on every change of the layout */
+#define DWG_SNAPSHOT_FORMAT 2
+
+/* Returns 1 if dat starts with a snapshot header */
+int dwg_is_snapshot (const Bit_Chain *dat);
+
+/* Appends the image of dwg to dat->chain, growing it as needed. */
+int dwg_encode_snapshot (Bit_Chain *restrict dat, Dwg_Data *restrict dwg);
+/* Restores dwg from the image in dat. Keeps dwg->opts. */
+int dwg_decode_snapshot (Bit_Chain *restrict dat, Dwg_Data *restrict dwg);
+
+#endif
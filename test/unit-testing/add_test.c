@@ -1021,6 +1021,78 @@ test_add (const Dwg_Object_Type type, const char *restrict file,
   return n_failed;
 }
 
+// write a LINE, read it back raw, add a 2nd LINE and save incrementally
+static int
+test_incremental (void)
+{
+  int error;
+  struct stat attrib;
+  off_t size;
+  Dwg_Data *dwg;
+  Dwg_Object_BLOCK_HEADER *hdr;
+  Dwg_Entity_LINE **lines;
+  dwg_point_3d pt1 = { 1.5, 2.5, 0.2 };
+  dwg_point_3d pt2 = { 2.5, 1.5, 0.0 };
+  dwg_point_3d pt3 = { 3.5, 0.5, 0.0 };
+  const char *dwgfile = "add_incremental_2000.dwg";
+  int n_failed;
+
+  failed = 0;
+  if (!stat (dwgfile, &attrib))
+    unlink (dwgfile);
+  dwg = dwg_new_Document (R_2000, 0, tracelevel);
+  hdr = dwg_model_space_object (dwg)->tio.object->tio.BLOCK_HEADER;
+  dwg_add_LINE (hdr, &pt1, &pt2);
+  error = dwg_write_file (dwgfile, dwg);
+  if (error >= DWG_ERR_CRITICAL)
+    {
+      fail ("write %s: %x", dwgfile, error);
+      return 1;
+    }
+  dwg_free (dwg);
+
+  dwg->opts = tracelevel | DWG_OPTS_KEEPRAW;
+  error = dwg_read_file (dwgfile, dwg);
+  if (error >= DWG_ERR_CRITICAL || stat (dwgfile, &attrib))
+    {
+      fail ("read %s: %x", dwgfile, error);
+      return 1;
+    }
+  size = attrib.st_size;
+  hdr = dwg_model_space_object (dwg)->tio.object->tio.BLOCK_HEADER;
+  dwg_add_LINE (hdr, &pt2, &pt3);
+  error = dwg_write_incremental (dwgfile, dwg);
+  if (error >= DWG_ERR_CRITICAL)
+    fail ("dwg_write_incremental %s: %x", dwgfile, error);
+  else if (stat (dwgfile, &attrib) || attrib.st_size <= size)
+    fail ("dwg_write_incremental %s did not append", dwgfile);
+  else
+    ok ("dwg_write_incremental %s: %ld => %ld", dwgfile, (long)size,
+        (long)attrib.st_size);
+  dwg_free (dwg);
+
+  dwg->opts = tracelevel;
+  error = dwg_read_file (dwgfile, dwg);
+  if (error >= DWG_ERR_CRITICAL)
+    {
+      fail ("re-read %s: %x", dwgfile, error);
+      return 1;
+    }
+  lines = dwg_getall_LINE (dwg_model_space_ref (dwg));
+  if (lines && lines[0] && lines[1] && !lines[2])
+    ok ("found 2 LINE's after the incremental save");
+  else
+    fail ("found not 2 LINE's after the incremental save");
+  free (lines);
+  dwg_free (dwg);
+  free (dwg);
+
+  n_failed = numfailed ();
+  if (!n_failed && (!debug || debug != -1))
+    unlink (dwgfile);
+  return n_failed;
+}
+
 static int test_names (void)
 {
   Dwg_Data *dwg;
@@ -1143,6 +1215,7 @@ main (int argc, char *argv[])
     debug = 0;
 
   error = test_names();
+  error += test_incremental ();
 
 #ifndef DISABLE_DXF
   for (; dxf < 2; dxf++)
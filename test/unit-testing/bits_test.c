@@ -394,6 +394,34 @@ bit_RL_tests (void)
   bitfree (&bitchain);
 }
 
+static void
+bit_MS_tests (void)
+{
+  /* two words: 0x1586e = 0x586e | 0x8000, 0x2 */
+  Bit_Chain bitchain = strtobt ("00000000"
+                                "00000000"
+                                "00000000"
+                                "00000000");
+  BITCODE_MS result;
+  bit_write_MS (&bitchain, 0x1586e);
+  if (bitchain.byte == 4 && bitchain.chain[0] == 0x6e
+      && bitchain.chain[1] == 0xd8 && bitchain.chain[2] == 0x02
+      && bitchain.chain[3] == 0)
+    pass ();
+  else
+    fail ("bit_write_MS %x %x %x %x", bitchain.chain[0], bitchain.chain[1],
+          bitchain.chain[2], bitchain.chain[3]);
+
+  bit_set_position (&bitchain, 0);
+  result = bit_read_MS (&bitchain);
+  if (result == 0x1586e)
+    pass ();
+  else
+    fail ("bit_read_MS 0x%x", (unsigned)result);
+
+  bitfree (&bitchain);
+}
+
 #if 0
 // MEASUREMENT section
 static void
@@ -1435,6 +1463,7 @@ main (int argc, char const *argv[])
   bit_RS_BE_tests ();
   bit_BS_tests ();
   bit_RL_tests ();
+  bit_MS_tests ();
   bit_BL_tests ();
   bit_RD_tests ();
   bit_BD_tests ();